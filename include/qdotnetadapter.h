@@ -6,22 +6,35 @@
 #pragma once
 
 #include "qdotnethost.h"
+#include "qdotnetsignature.h"
 
 #ifdef __GNUC__
 #   pragma GCC diagnostic push
 #   pragma GCC diagnostic ignored "-Wconversion"
 #endif
+#include <QAtomicInteger>
+#include <QAtomicPointer>
 #include <QCoreApplication>
 #include <QDir>
+#include <QFuture>
+#include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QMutexLocker>
+#include <QReadWriteLock>
 #include <QString>
+#include <QStringView>
 #ifdef __GNUC__
 #   pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <functional>
+
 class QDotNetRef;
 
+#define QDOTNETADAPTER_FN(f) resolve(fn##f, Function::f)
+
 class QDotNetAdapter final
 {
 private:
@@ -59,9 +72,14 @@ public:
         if (instance().isValid())
             return;
 
+        // Callers that arrive while the adapter is being initialized (e.g. by warmUpAsync())
+        // wait here until initialization is complete.
+        QMutexLocker initLocker(&instance().initMutex);
+        if (instance().isValid())
+            return;
+
         const QString typeFullName = QString("%1, %2").arg(typeName, assemblyName);
-        const QString delegateName = QString("%1+Delegates+%3, %2")
-            .arg(typeName, assemblyName, "%1");
+        const QString unmanagedTypeName = QString("%1+Unmanaged, %2").arg(typeName, assemblyName);
 
         QDotNetHost *host = nullptr;
         if (externalHost != nullptr)
@@ -73,29 +91,33 @@ public:
             return;
         }
 
-#define QDOTNETADAPTER_DELEGATE(d) \
-    instance().fn##d, assemblyPath, typeFullName, #d, delegateName.arg(#d)
-
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(LoadAssembly));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(ResolveStaticMethod));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(ResolveConstructor));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(ResolveInstanceMethod));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(ResolveSafeMethod));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(AddEventHandler));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(RemoveEventHandler));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(RemoveAllEventHandlers));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(AddObjectRef));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(FreeDelegateRef));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(FreeObjectRef));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(FreeTypeRef));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(AddInterfaceProxy));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(SetInterfaceMethod));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(Stats));
-        host->resolveFunction(QDOTNETADAPTER_DELEGATE(GetObject));
-
-#undef QDOTNETADAPTER_DELEGATE
+        // Adapter functions are obtained from the function table filled in by the adapter's
+        // bootstrap entry point. Functions missing from the table are resolved on first use
+        // (see resolve()).
+        instance().assemblyPath = assemblyPath;
+        instance().typeFullName = typeFullName;
+        instance().unmanagedTypeName = unmanagedTypeName;
+        instance().bootstrap(host);
+        instance().host.storeRelease(host);
+        instance().setRefFreedCallback();
+    }
 
-        instance().host = host;
+    // Initialize the adapter in a background thread: load the host (if not yet loaded),
+    // bootstrap the adapter function table and then call each of the warm-up functions, e.g. to
+    // pre-resolve methods that are needed early on. Functions that use the adapter in the
+    // meantime block only until the adapter is initialized, not until warm-up is complete.
+    static QFuture<bool> warmUpAsync(QDotNetHost *externalHost = nullptr,
+        const QList<std::function<void()>> &warmUp = {})
+    {
+        return QtDotNet::runAsync([externalHost, warmUp]
+        {
+            init(externalHost);
+            if (!instance().isValid())
+                return false;
+            for (const auto &func : warmUp)
+                func();
+            return true;
+        });
     }
 
     static QDotNetAdapter &instance()
@@ -104,50 +126,313 @@ public:
         return adapter;
     }
 
-    bool isValid() const { return host != nullptr; }
+    bool isValid() const { return host.loadAcquire() != nullptr; }
+
+    // Resolve all adapter functions at once, instead of on first use.
+    bool resolveAll() const
+    {
+        init();
+        if (!isValid())
+            return false;
+        bool ok = true;
+        ok = QDOTNETADAPTER_FN(LoadAssembly).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveStaticMethod).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveConstructor).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveInstanceMethod).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveSafeMethod).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(AddEventHandler).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(RemoveEventHandler).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(RemoveAllEventHandlers).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(AddObjectRef).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(FreeDelegateRef).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(FreeObjectRef).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(FreeTypeRef).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(AddInterfaceProxy).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(SetInterfaceMethod).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(Stats).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(GetObject).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(GetGCInfo).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(StartProfile).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(SaveProfile).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ReplayProfile).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(SetPrepareMode).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(GetCounters).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveOpenInstanceMethod).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(SetRefFreedCallback).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(GetObjectTypeName).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(RegisterSignature).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveStaticMethodById).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveConstructorById).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveInstanceMethodById).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveOpenInstanceMethodById).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveSafeMethodById).isValid() && ok;
+        ok = QDOTNETADAPTER_FN(ResolveMany).isValid() && ok;
+        return ok;
+    }
 
 public:
     bool loadAssembly(const QString &assemblyName) const
     {
         init();
-        return fnLoadAssembly(assemblyName);
+        return QDOTNETADAPTER_FN(LoadAssembly)(assemblyName, length(assemblyName)) != 0;
     }
 
+    // JIT pre-compilation of resolved methods. Without pre-compilation, a method is compiled
+    // the first time it is called.
+    enum class PrepareMode : qint32
+    {
+        // Use the mode set with setPrepareMode() (per-resolve mode only).
+        Default,
+        // Compile methods on first call.
+        Off,
+        // Compile methods when resolved.
+        Sync,
+        // Compile methods in a background thread after being resolved.
+        Background
+    };
+
+    // Set the pre-compilation mode for methods resolved from now on.
+    void setPrepareMode(PrepareMode mode) const
+    {
+        init();
+        QDOTNETADAPTER_FN(SetPrepareMode)(static_cast<qint32>(mode));
+    }
+
+    // Methods are resolved with a signature, i.e. the parameter info of the return type and of
+    // each argument (see QDotNetSignature and QtDotNet::signature()). Overloads that take a
+    // list of parameters are provided for convenience.
     void *resolveStaticMethod(const QString &typeName, const QString &methodName,
-        const QList<QDotNetParameter> &params) const
+        const QDotNetSignature &signature, PrepareMode prepare = PrepareMode::Default) const
     {
         init();
         if (typeName.isEmpty() || methodName.isEmpty())
             return nullptr;
-        return fnResolveStaticMethod(typeName, methodName,
-            static_cast<qint32>(params.size()), params);
+        const ResolveKey key{ ResolveKind::Static, nullptr, typeName, methodName,
+            signature.hash() };
+        return cachedResolve(key, signature, [&] {
+            if (const qint32 id = registerSignature(signature)) {
+                return QDOTNETADAPTER_FN(ResolveStaticMethodById)(typeName, length(typeName),
+                    methodName, length(methodName), id, static_cast<qint32>(prepare));
+            }
+            QList<QDotNetParameter> prepared;
+            return QDOTNETADAPTER_FN(ResolveStaticMethod)(typeName, length(typeName),
+                methodName, length(methodName), static_cast<qint32>(signature.size()),
+                withPrepareMode(signature, prepare, prepared));
+        });
+    }
+
+    void *resolveStaticMethod(const QString &typeName, const QString &methodName,
+        const QList<QDotNetParameter> &params, PrepareMode prepare = PrepareMode::Default) const
+    {
+        return resolveStaticMethod(typeName, methodName, QDotNetSignature(params), prepare);
     }
 
-    void *resolveConstructor(const QList<QDotNetParameter> &params) const
+    // The signature of a constructor starts with the type of the object to create.
+    void *resolveConstructor(const QDotNetSignature &signature,
+        PrepareMode prepare = PrepareMode::Default) const
     {
         init();
-        return fnResolveConstructor(static_cast<qint32>(params.size()), params);
+        const ResolveKey key{ ResolveKind::Constructor, nullptr, {}, {}, signature.hash() };
+        return cachedResolve(key, signature, [&] {
+            if (const qint32 id = registerSignature(signature))
+                return QDOTNETADAPTER_FN(ResolveConstructorById)(id, static_cast<qint32>(prepare));
+            QList<QDotNetParameter> prepared;
+            return QDOTNETADAPTER_FN(ResolveConstructor)(static_cast<qint32>(signature.size()),
+                withPrepareMode(signature, prepare, prepared));
+        });
+    }
+
+    void *resolveConstructor(const QList<QDotNetParameter> &params,
+        PrepareMode prepare = PrepareMode::Default) const
+    {
+        return resolveConstructor(QDotNetSignature(params), prepare);
     }
 
     void *resolveInstanceMethod(const QDotNetRef &objectRef, const QString &methodName,
-        const QList<QDotNetParameter> &params) const
+        const QDotNetSignature &signature, PrepareMode prepare = PrepareMode::Default) const
     {
         init();
         if (QtDotNet::isNull(objectRef) || methodName.isEmpty())
             return nullptr;
-        return fnResolveInstanceMethod(
-            objectRef, methodName, static_cast<qint32>(params.size()), params);
+        const ResolveKey key{ ResolveKind::Instance, QtDotNet::gcHandle(objectRef), {},
+            methodName, signature.hash() };
+        return cachedResolve(key, signature, [&] {
+            if (const qint32 id = registerSignature(signature)) {
+                return QDOTNETADAPTER_FN(ResolveInstanceMethodById)(objectRef, methodName,
+                    length(methodName), id, static_cast<qint32>(prepare));
+            }
+            QList<QDotNetParameter> prepared;
+            return QDOTNETADAPTER_FN(ResolveInstanceMethod)(objectRef, methodName,
+                length(methodName), static_cast<qint32>(signature.size()),
+                withPrepareMode(signature, prepare, prepared));
+        });
+    }
+
+    void *resolveInstanceMethod(const QDotNetRef &objectRef, const QString &methodName,
+        const QList<QDotNetParameter> &params, PrepareMode prepare = PrepareMode::Default) const
+    {
+        return resolveInstanceMethod(objectRef, methodName, QDotNetSignature(params), prepare);
+    }
+
+    // Resolve an instance method as a function that takes the target object as its first
+    // argument; the signature must include the target object, after the return type.
+    void *resolveOpenInstanceMethod(const QString &typeName, const QString &methodName,
+        const QDotNetSignature &signature, PrepareMode prepare = PrepareMode::Default) const
+    {
+        init();
+        if (typeName.isEmpty() || methodName.isEmpty() || signature.size() < 2)
+            return nullptr;
+        const ResolveKey key{ ResolveKind::OpenInstance, nullptr, typeName, methodName,
+            signature.hash() };
+        return cachedResolve(key, signature, [&] {
+            if (const qint32 id = registerSignature(signature)) {
+                return QDOTNETADAPTER_FN(ResolveOpenInstanceMethodById)(typeName,
+                    length(typeName), methodName, length(methodName), id,
+                    static_cast<qint32>(prepare));
+            }
+            QList<QDotNetParameter> prepared;
+            return QDOTNETADAPTER_FN(ResolveOpenInstanceMethod)(typeName, length(typeName),
+                methodName, length(methodName), static_cast<qint32>(signature.size()),
+                withPrepareMode(signature, prepare, prepared));
+        });
+    }
+
+    void *resolveOpenInstanceMethod(const QString &typeName, const QString &methodName,
+        const QList<QDotNetParameter> &params, PrepareMode prepare = PrepareMode::Default) const
+    {
+        return resolveOpenInstanceMethod(typeName, methodName, QDotNetSignature(params),
+            prepare);
+    }
+
+    // Kind of method to resolve, in a batch of requests (see resolveMany()).
+    enum class ResolveKind : quint8
+    {
+        Static,
+        Constructor,
+        Instance,
+        OpenInstance
+    };
+
+    // Request to resolve a method, as part of a batch. Signatures follow the same rules as the
+    // corresponding resolve function (e.g. the signature of a constructor starts with the type
+    // of the object to create, and the method name is ignored).
+    struct ResolveRequest
+    {
+        ResolveKind kind;
+        QString methodName;
+        QDotNetSignature signature;
+    };
+
+    // Resolve static methods, open instance methods and constructors of a type, with one call
+    // into the adapter. The type's methods are looked up once for the whole batch. Returns the
+    // function pointer of each requested method, in the same order as the requests (nullptr
+    // for methods not resolved). Instance methods cannot be resolved against a type.
+    QList<void *> resolveMany(const QString &typeName, const QList<ResolveRequest> &requests,
+        PrepareMode prepare = PrepareMode::Default) const
+    {
+        return resolveMany(typeName, nullptr, requests, prepare);
+    }
+
+    // Resolve instance methods of an object (and constructors), with a single call into the
+    // adapter (see above).
+    QList<void *> resolveMany(const QDotNetRef &objectRef, const QList<ResolveRequest> &requests,
+        PrepareMode prepare = PrepareMode::Default) const
+    {
+        if (QtDotNet::isNull(objectRef))
+            return QList<void *>(requests.size(), nullptr);
+        return resolveMany({}, &objectRef, requests, prepare);
+    }
+
+    // Register a signature with the adapter; methods are then resolved by signature ID, with
+    // no parameter info being passed. Signatures are registered on first use and the IDs are
+    // kept for the lifetime of the adapter. Returns 0 if the signature cannot be registered
+    // (methods are then resolved with the full list of parameters).
+    qint32 registerSignature(const QDotNetSignature &signature) const
+    {
+        init();
+        {
+            QReadLocker locker(&signatureLock);
+            const auto entry = signatureIds.constFind(signature.hash());
+            if (entry != signatureIds.constEnd())
+                return entry->signature.matches(signature) ? entry->id : 0;
+        }
+        const auto &fnRegister = QDOTNETADAPTER_FN(RegisterSignature);
+        if (!fnRegister.isValid())
+            return 0;
+        const qint32 id = fnRegister(static_cast<qint32>(signature.size()), signature.data());
+        if (id <= 0)
+            return 0;
+
+        QWriteLocker locker(&signatureLock);
+        // On a hash collision, the signature registered first keeps the entry.
+        const auto entry = signatureIds.constFind(signature.hash());
+        if (entry != signatureIds.constEnd())
+            return entry->signature.matches(signature) ? entry->id : 0;
+        signatureIds.insert(signature.hash(), { id, StoredSignature(signature) });
+        return id;
+    }
+
+    // Resolved methods (static methods, constructors, instance methods and open instance
+    // methods) are cached, so that resolving the same method again returns the same function
+    // pointer without calling into the adapter. The adapter notifies the cache whenever a
+    // delegate or object ref. is released (e.g. by freeTypeRef()), and the corresponding
+    // entries are removed.
+    struct ResolveCacheStats
+    {
+        qint64 hits;
+        qint64 misses;
+        qint64 size;
+    };
+
+    ResolveCacheStats resolveCacheStats() const
+    {
+        QReadLocker locker(&resolveCacheLock);
+        return { resolveCacheHits.loadRelaxed(), resolveCacheMisses.loadRelaxed(),
+            static_cast<qint64>(resolveCache.size()) };
+    }
+
+    void setResolveCacheEnabled(bool enabled) const
+    {
+        resolveCacheEnabled.storeRelease(enabled ? 1 : 0);
+        if (!enabled)
+            clearResolveCache();
+    }
+
+    void clearResolveCache() const
+    {
+        QWriteLocker locker(&resolveCacheLock);
+        resolveCacheEpoch.fetchAndAddRelaxed(1);
+        resolveCache.clear();
+        resolveCacheIndex.clear();
+    }
+
+    // Methods cached at call sites (see QDotNetCallSite) remain valid as long as the call-site
+    // generation does not change. The generation changes whenever a function pointer that
+    // might be cached at a call site (i.e. other than a closed instance method) is released.
+    // Zero means that call-site caching is not available.
+    quint32 callSiteGeneration() const
+    {
+        return refFreedCallbackSet.loadAcquire() ? callSiteGen.loadAcquire() : 0;
     }
 
     using EventCallback = void(QDOTNETFUNCTION_CALLTYPE *)(void *, void *, void *, void *);
 
-    void *resolveSafeMethod(void *funcPtr, const QList<QDotNetParameter> &params) const
+    void *resolveSafeMethod(void *funcPtr, const QDotNetSignature &signature) const
     {
         init();
         if (!funcPtr)
             return nullptr;
-        return fnResolveSafeMethod(
-            funcPtr, static_cast<qint32>(params.size()), params);
+        if (const qint32 id = registerSignature(signature)) {
+            return QDOTNETADAPTER_FN(ResolveSafeMethodById)(
+                funcPtr, id, static_cast<qint32>(PrepareMode::Default));
+        }
+        return QDOTNETADAPTER_FN(ResolveSafeMethod)(
+            funcPtr, static_cast<qint32>(signature.size()), signature.data());
+    }
+
+    void *resolveSafeMethod(void *funcPtr, const QList<QDotNetParameter> &params) const
+    {
+        return resolveSafeMethod(funcPtr, QDotNetSignature(params));
     }
 
     void addEventHandler(const QDotNetRef &eventSource, const QString &eventName,
@@ -156,7 +441,8 @@ public:
         init();
         if (QtDotNet::isNull(eventSource) || eventName.isEmpty() || !eventCallback)
             return;
-        fnAddEventHandler(eventSource, eventName, context, eventCallback);
+        QDOTNETADAPTER_FN(AddEventHandler)(eventSource, eventName, length(eventName),
+            context, eventCallback);
     }
 
     void addEventHandler(QDotNetRef &eventSource, const QString &eventName,
@@ -165,7 +451,8 @@ public:
         init();
         if (QtDotNet::isNull(eventSource) || eventName.isEmpty() || !eventCallback)
             return;
-        fnAddEventHandler(eventSource, eventName, &eventSource, eventCallback);
+        QDOTNETADAPTER_FN(AddEventHandler)(eventSource, eventName, length(eventName),
+            &eventSource, eventCallback);
     }
 
     void removeEventHandler(const QDotNetRef &eventSource, const QString &eventName,
@@ -174,7 +461,8 @@ public:
         init();
         if (QtDotNet::isNull(eventSource) || eventName.isEmpty())
             return;
-        fnRemoveEventHandler(eventSource, eventName, context);
+        QDOTNETADAPTER_FN(RemoveEventHandler)(eventSource, eventName, length(eventName),
+            context);
     }
 
     void removeEventHandler(QDotNetRef &eventSource, const QString &eventName) const
@@ -182,7 +470,8 @@ public:
         init();
         if (QtDotNet::isNull(eventSource) || eventName.isEmpty())
             return;
-        fnRemoveEventHandler(eventSource, eventName, &eventSource);
+        QDOTNETADAPTER_FN(RemoveEventHandler)(eventSource, eventName, length(eventName),
+            &eventSource);
     }
 
     void removeAllEventHandlers(const QDotNetRef &eventSource) const
@@ -190,7 +479,7 @@ public:
         init();
         if (QtDotNet::isNull(eventSource))
             return;
-        fnRemoveAllEventHandlers(eventSource);
+        QDOTNETADAPTER_FN(RemoveAllEventHandlers)(eventSource);
     }
 
     void *addObjectRef(const QDotNetRef &objectRef, bool weakRef = false) const
@@ -198,7 +487,7 @@ public:
         init();
         if (QtDotNet::isNull(objectRef))
             return nullptr;
-        return fnAddObjectRef(objectRef, weakRef);
+        return QDOTNETADAPTER_FN(AddObjectRef)(objectRef, weakRef ? 1 : 0);
     }
 
     void freeDelegateRef(void *delegateRef) const
@@ -206,7 +495,7 @@ public:
         init();
         if (!delegateRef)
             return;
-        fnFreeDelegateRef(delegateRef);
+        QDOTNETADAPTER_FN(FreeDelegateRef)(delegateRef);
     }
 
     void freeObjectRef(const QDotNetRef &objectRef) const
@@ -214,7 +503,7 @@ public:
         init();
         if (QtDotNet::isNull(objectRef))
             return;
-        fnFreeObjectRef(objectRef);
+        QDOTNETADAPTER_FN(FreeObjectRef)(objectRef);
     }
 
     void freeTypeRef(const QString &typeName) const
@@ -222,7 +511,7 @@ public:
         init();
         if (typeName.isEmpty())
             return;
-        fnFreeTypeRef(typeName);
+        QDOTNETADAPTER_FN(FreeTypeRef)(typeName, length(typeName));
     }
 
     void *addInterfaceProxy(const QString &interfaceName) const
@@ -230,7 +519,7 @@ public:
         init();
         if (interfaceName.isEmpty())
             return nullptr;
-        return fnAddInterfaceProxy(interfaceName);
+        return QDOTNETADAPTER_FN(AddInterfaceProxy)(interfaceName, length(interfaceName));
     }
 
     void setInterfaceMethod(const QDotNetRef &obj, const QString &methodName,
@@ -239,8 +528,8 @@ public:
         init();
         if (QtDotNet::isNull(obj) || methodName.isEmpty() || !callback)
             return;
-        return fnSetInterfaceMethod(obj, methodName, static_cast<qint32>(params.size()), params,
-            callback, cleanUp, context);
+        return QDOTNETADAPTER_FN(SetInterfaceMethod)(obj, methodName, length(methodName),
+            static_cast<qint32>(params.size()), params, callback, cleanUp, context);
     }
 
     struct Stats
@@ -260,40 +549,666 @@ public:
     {
         Stats s{ };
         init();
-        fnStats(&s.refCount, &s.staticCount, &s.eventCount);
+        QDOTNETADAPTER_FN(Stats)(&s.refCount, &s.staticCount, &s.eventCount);
         return s;
     }
 
+    // Garbage collector mode and statistics (see GCSettings and GC.GetGCMemoryInfo()).
+    struct GCInfo
+    {
+        qint32 isServerGC;
+        qint32 latencyMode;
+        qint64 heapSizeBytes;
+        qint64 totalCommittedBytes;
+        qint64 totalAvailableMemoryBytes;
+        qint64 lastPauseDurationTicks;
+        qint64 gen0Collections;
+        qint64 gen1Collections;
+        qint64 gen2Collections;
+        double pauseTimePercentage;
+    };
+
+    GCInfo gcInfo() const
+    {
+        GCInfo info{ };
+        init();
+        QDOTNETADAPTER_FN(GetGCInfo)(&info);
+        return info;
+    }
+
     void *object(const QDotNetRef &obj, const QString &path)
     {
         init();
-        return fnGetObject(obj, path);
+        return QDOTNETADAPTER_FN(GetObject)(obj, path, length(path));
+    }
+
+    // Assembly-qualified name of the runtime type of an object.
+    QString objectTypeName(const QDotNetRef &obj) const
+    {
+        init();
+        if (QtDotNet::isNull(obj))
+            return {};
+        QString typeName(defaultTypeNameSize, Qt::Uninitialized);
+        qint32 size = QDOTNETADAPTER_FN(GetObjectTypeName)(obj, typeName.data(), length(typeName));
+        if (size > length(typeName)) {
+            typeName.resize(size);
+            size = QDOTNETADAPTER_FN(GetObjectTypeName)(obj, typeName.data(), length(typeName));
+        }
+        if (size < 0 || size > length(typeName))
+            return {};
+        typeName.resize(size);
+        return typeName;
+    }
+
+    // Adapter counters; new counters are appended to the end.
+    enum class Counter : qint32
+    {
+        // Methods pre-compiled (see PrepareMode).
+        PreparedMethods,
+        PrepareFailures,
+        PrepareMicroseconds,
+        // Types looked up by name (shared by all adapter operations).
+        TypeCacheHits,
+        TypeCacheMisses,
+        // Interop code generated at run-time: types (never unloaded), lightweight methods
+        // (reclaimed when no longer used), entries currently in the code generator caches, and
+        // entries evicted from the caches (least recently used) or released by freeTypeRef().
+        GeneratedTypes,
+        GeneratedMethods,
+        LiveGeneratedCode,
+        EvictedGeneratedCode,
+        Count
+    };
+
+    QList<qint64> counters() const
+    {
+        QList<qint64> values(static_cast<qsizetype>(Counter::Count), 0);
+        init();
+        QDOTNETADAPTER_FN(GetCounters)(values.data(), static_cast<qint32>(values.size()));
+        return values;
+    }
+
+    qint64 counter(Counter counter) const
+    {
+        return counters().value(static_cast<qsizetype>(counter));
+    }
+
+    // Start recording the signatures of resolved methods (static methods, constructors and
+    // instance methods). The recorded profile can be saved with saveProfile() and replayed on
+    // the next run with replayProfile(), ahead of the methods being needed.
+    void startProfile() const
+    {
+        init();
+        // Methods found in the resolve cache would not be recorded.
+        clearResolveCache();
+        QDOTNETADAPTER_FN(StartProfile)();
+    }
+
+    bool saveProfile(const QString &path) const
+    {
+        init();
+        if (path.isEmpty())
+            return false;
+        return QDOTNETADAPTER_FN(SaveProfile)(path, length(path)) != 0;
+    }
+
+    // Generate the delegate types and JIT-compile the methods listed in a profile. Returns the
+    // number of methods prepared, or -1 if the profile could not be read.
+    qint32 replayProfile(const QString &path) const
+    {
+        init();
+        if (path.isEmpty())
+            return -1;
+        return QDOTNETADAPTER_FN(ReplayProfile)(path, length(path));
+    }
+
+    // Initialize the adapter and replay a profile in a background thread (see warmUpAsync()).
+    static QFuture<bool> replayProfileAsync(const QString &path,
+        QDotNetHost *externalHost = nullptr)
+    {
+        return warmUpAsync(externalHost, {
+            [path] {
+                if (instance().replayProfile(path) < 0)
+                    qWarning() << "QDotNetAdapter: error replaying profile:" << path;
+            }
+        });
     }
 
 private:
+    enum class Function : quint32
+    {
+        LoadAssembly,
+        ResolveStaticMethod,
+        ResolveConstructor,
+        ResolveInstanceMethod,
+        ResolveSafeMethod,
+        AddEventHandler,
+        RemoveEventHandler,
+        RemoveAllEventHandlers,
+        AddObjectRef,
+        FreeDelegateRef,
+        FreeObjectRef,
+        FreeTypeRef,
+        AddInterfaceProxy,
+        SetInterfaceMethod,
+        Stats,
+        GetObject,
+        GetGCInfo,
+        StartProfile,
+        SaveProfile,
+        ReplayProfile,
+        SetPrepareMode,
+        GetCounters,
+        ResolveOpenInstanceMethod,
+        SetRefFreedCallback,
+        GetObjectTypeName,
+        RegisterSignature,
+        ResolveStaticMethodById,
+        ResolveConstructorById,
+        ResolveInstanceMethodById,
+        ResolveOpenInstanceMethodById,
+        ResolveSafeMethodById,
+        ResolveMany,
+        Count
+    };
+    static_assert(static_cast<quint32>(Function::Count) <= 64);
+
+    static inline const char *const functionNames[] = {
+        "LoadAssembly",
+        "ResolveStaticMethod",
+        "ResolveConstructor",
+        "ResolveInstanceMethod",
+        "ResolveSafeMethod",
+        "AddEventHandler",
+        "RemoveEventHandler",
+        "RemoveAllEventHandlers",
+        "AddObjectRef",
+        "FreeDelegateRef",
+        "FreeObjectRef",
+        "FreeTypeRef",
+        "AddInterfaceProxy",
+        "SetInterfaceMethod",
+        "Stats",
+        "GetObject",
+        "GetGCInfo",
+        "StartProfile",
+        "SaveProfile",
+        "ReplayProfile",
+        "SetPrepareMode",
+        "GetCounters",
+        "ResolveOpenInstanceMethod",
+        "SetRefFreedCallback",
+        "GetObjectTypeName",
+        "RegisterSignature",
+        "ResolveStaticMethodById",
+        "ResolveConstructorById",
+        "ResolveInstanceMethodById",
+        "ResolveOpenInstanceMethodById",
+        "ResolveSafeMethodById",
+        "ResolveMany",
+    };
+
+    static qint32 length(const QString &str)
+    {
+        return static_cast<qint32>(str.size());
+    }
+
+    // The prepare mode is passed in the parameter info of the return type. Signatures are
+    // shared, so the parameters are copied to the given storage before being modified.
+    static const QDotNetParameter *withPrepareMode(const QDotNetSignature &signature,
+        PrepareMode mode, QList<QDotNetParameter> &storage)
+    {
+        if (mode == PrepareMode::Default || signature.isEmpty())
+            return signature.data();
+        storage = signature.toList();
+        constexpr auto offset = FLAGS_OFFSET + FLAGS_PREPARE_BIT;
+        storage[0].paramInfo &= ~(MASK(~0ull, FLAGS_PREPARE_SIZE) << offset);
+        storage[0].paramInfo |= MASK(mode, FLAGS_PREPARE_SIZE) << offset;
+        return storage.constData();
+    }
+
+    // Cached methods are identified by the target type name (static and open instance
+    // methods) or the target object ref. (instance methods), the method name and a hash of
+    // the signature. The full signature is stored in the entry and checked on lookup.
+    struct ResolveKey
+    {
+        ResolveKind kind;
+        const void *objectRef;
+        QString typeName;
+        QString methodName;
+        quint64 signatureHash;
+
+        bool operator==(const ResolveKey &other) const
+        {
+            return kind == other.kind
+                && objectRef == other.objectRef
+                && signatureHash == other.signatureHash
+                && typeName == other.typeName
+                && methodName == other.methodName;
+        }
+
+        friend size_t qHash(const ResolveKey &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, static_cast<quint8>(key.kind), key.objectRef,
+                key.typeName, key.methodName, key.signatureHash);
+        }
+    };
+
+    // Copy of a signature, i.e. the type name and parameter info of each parameter.
+    struct StoredSignature
+    {
+        QList<std::pair<QString, quint64>> params;
+
+        StoredSignature() = default;
+        explicit StoredSignature(const QDotNetSignature &signature)
+        {
+            params.reserve(signature.size());
+            for (const auto &param : signature)
+                params.append({ paramTypeName(param).toString(), param.paramInfo });
+        }
+
+        bool matches(const QDotNetSignature &other) const
+        {
+            if (params.size() != other.size())
+                return false;
+            for (qsizetype i = 0; i < other.size(); ++i) {
+                if (params[i].second != other[i].paramInfo
+                    || params[i].first != paramTypeName(other[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    struct ResolveEntry
+    {
+        void *funcPtr = nullptr;
+        StoredSignature signature;
+    };
+
+    struct SignatureEntry
+    {
+        qint32 id = 0;
+        StoredSignature signature;
+    };
+
+    // Kind of ref. passed to onRefFreed() (see Adapter.RefKind).
+    enum class RefKind : qint32
+    {
+        Delegate,
+        Object
+    };
+
+    using RefFreedCallback = void(QDOTNETFUNCTION_CALLTYPE *)(qint32, void *);
+
+    static QStringView paramTypeName(const QDotNetParameter &param)
+    {
+        return param.typeName ? QStringView(param.typeName) : QStringView();
+    }
+
+    bool isResolveCacheActive() const
+    {
+        return resolveCacheEnabled.loadAcquire() && refFreedCallbackSet.loadAcquire();
+    }
+
+    // Look up a method in the resolve cache; counts a hit or a miss.
+    bool findCached(const ResolveKey &key, const QDotNetSignature &signature,
+        void *&funcPtr) const
+    {
+        {
+            QReadLocker locker(&resolveCacheLock);
+            const auto entry = resolveCache.constFind(key);
+            if (entry != resolveCache.constEnd() && entry->signature.matches(signature)) {
+                resolveCacheHits.fetchAndAddRelaxed(1);
+                funcPtr = entry->funcPtr;
+                return true;
+            }
+        }
+        resolveCacheMisses.fetchAndAddRelaxed(1);
+        return false;
+    }
+
+    template<typename TResolve>
+    void *cachedResolve(const ResolveKey &key, const QDotNetSignature &signature,
+        TResolve resolveMethod) const
+    {
+        if (!isResolveCacheActive())
+            return resolveMethod();
+        void *funcPtr = nullptr;
+        if (findCached(key, signature, funcPtr))
+            return funcPtr;
+
+        const quint32 epoch = resolveCacheEpoch.loadAcquire();
+        funcPtr = resolveMethod();
+        if (funcPtr != nullptr)
+            insertCached(key, signature, funcPtr, epoch);
+        return funcPtr;
+    }
+
+    // Add a resolved method to the cache, unless refs were released since the given epoch.
+    void insertCached(const ResolveKey &key, const QDotNetSignature &signature, void *funcPtr,
+        quint32 epoch) const
+    {
+        const ResolveEntry newEntry{ funcPtr, StoredSignature(signature) };
+
+        QWriteLocker locker(&resolveCacheLock);
+        // Refs released in the meantime might include the one just resolved.
+        if (resolveCacheEpoch.loadRelaxed() != epoch)
+            return;
+        const auto oldEntry = resolveCache.constFind(key);
+        if (oldEntry != resolveCache.constEnd()) {
+            removeFromIndex(oldEntry->funcPtr, key);
+            removeFromIndex(key.objectRef, key);
+        }
+        resolveCache.insert(key, newEntry);
+        resolveCacheIndex[funcPtr].append(key);
+        if (key.objectRef != nullptr)
+            resolveCacheIndex[key.objectRef].append(key);
+    }
+
+    // Layout of a request passed to the adapter's ResolveMany function.
+    struct NativeResolveRequest
+    {
+        const QChar *methodName;
+        qint32 methodNameLength;
+        qint32 kind;
+        qint32 signatureId;
+        qint32 prepareMode;
+    };
+
+    QList<void *> resolveMany(const QString &typeName, const QDotNetRef *objectRef,
+        const QList<ResolveRequest> &requests, PrepareMode prepare) const
+    {
+        init();
+        const void *objectHandle = objectRef ? QtDotNet::gcHandle(*objectRef) : nullptr;
+        QList<void *> funcPtrs(requests.size(), nullptr);
+        const bool useCache = isResolveCacheActive();
+        const quint32 epoch = resolveCacheEpoch.loadAcquire();
+
+        // Requests not found in the cache are sent to the adapter in one batch.
+        QList<NativeResolveRequest> batch;
+        QList<qsizetype> batchIndex;
+        QList<ResolveKey> batchKeys;
+        for (qsizetype i = 0; i < requests.size(); ++i) {
+            const ResolveRequest &request = requests[i];
+            const bool isCtor = request.kind == ResolveKind::Constructor;
+            const bool isInstance = request.kind == ResolveKind::Instance;
+            if ((!isCtor && request.methodName.isEmpty())
+                || (isInstance ? objectHandle == nullptr : !isCtor && typeName.isEmpty())
+                || (request.kind == ResolveKind::OpenInstance && request.signature.size() < 2)) {
+                continue;
+            }
+            const ResolveKey key{ request.kind, isInstance ? objectHandle : nullptr,
+                isCtor || isInstance ? QString() : typeName,
+                isCtor ? QString() : request.methodName, request.signature.hash() };
+            if (useCache && findCached(key, request.signature, funcPtrs[i]))
+                continue;
+
+            // On a signature hash collision, the method is resolved on its own.
+            const qint32 id = registerSignature(request.signature);
+            if (id == 0) {
+                funcPtrs[i] = resolveOne(typeName, objectRef, request, prepare);
+                continue;
+            }
+            batch.append({ isCtor ? nullptr : request.methodName.constData(),
+                isCtor ? 0 : length(request.methodName), static_cast<qint32>(request.kind), id,
+                static_cast<qint32>(prepare) });
+            batchIndex.append(i);
+            batchKeys.append(key);
+        }
+        if (batch.isEmpty())
+            return funcPtrs;
+
+        QList<void *> batchPtrs(batch.size(), nullptr);
+        const auto &fnResolveMany = QDOTNETADAPTER_FN(ResolveMany);
+        if (!fnResolveMany.isValid()) {
+            for (qsizetype i = 0; i < batchIndex.size(); ++i) {
+                funcPtrs[batchIndex[i]]
+                    = resolveOne(typeName, objectRef, requests[batchIndex[i]], prepare);
+            }
+            return funcPtrs;
+        }
+        fnResolveMany(typeName, length(typeName), objectHandle,
+            static_cast<qint32>(batch.size()), batch.constData(), batchPtrs.data());
+        for (qsizetype i = 0; i < batchIndex.size(); ++i) {
+            void *funcPtr = batchPtrs[i];
+            funcPtrs[batchIndex[i]] = funcPtr;
+            if (useCache && funcPtr != nullptr)
+                insertCached(batchKeys[i], requests[batchIndex[i]].signature, funcPtr, epoch);
+        }
+        return funcPtrs;
+    }
+
+    void *resolveOne(const QString &typeName, const QDotNetRef *objectRef,
+        const ResolveRequest &request, PrepareMode prepare) const
+    {
+        switch (request.kind) {
+        case ResolveKind::Static:
+            return resolveStaticMethod(typeName, request.methodName, request.signature, prepare);
+        case ResolveKind::Constructor:
+            return resolveConstructor(request.signature, prepare);
+        case ResolveKind::Instance:
+            return objectRef ? resolveInstanceMethod(*objectRef, request.methodName,
+                request.signature, prepare) : nullptr;
+        case ResolveKind::OpenInstance:
+            return resolveOpenInstanceMethod(typeName, request.methodName, request.signature,
+                prepare);
+        }
+        return nullptr;
+    }
+
+    void removeFromIndex(const void *ref, const ResolveKey &key) const
+    {
+        if (ref == nullptr)
+            return;
+        const auto keys = resolveCacheIndex.find(ref);
+        if (keys == resolveCacheIndex.end())
+            return;
+        keys->removeOne(key);
+        if (keys->isEmpty())
+            resolveCacheIndex.erase(keys);
+    }
+
+    // Called by the adapter before a delegate ref. (i.e. function pointer) or an object ref.
+    // is released; cached entries that refer to it are removed.
+    static void QDOTNETFUNCTION_CALLTYPE onRefFreed(qint32 refKind, void *ref)
+    {
+        const QDotNetAdapter &adapter = instance();
+        const bool isDelegate = static_cast<RefKind>(refKind) == RefKind::Delegate;
+        QWriteLocker locker(&adapter.resolveCacheLock);
+        adapter.resolveCacheEpoch.fetchAndAddRelaxed(1);
+        const QList<ResolveKey> keys = adapter.resolveCacheIndex.take(ref);
+
+        // Closed instance methods are not cached at call sites; any other function pointer
+        // (including those not found in the cache) might be.
+        const bool isInstanceMethod = !keys.isEmpty()
+            && std::all_of(keys.begin(), keys.end(), [](const ResolveKey &key) {
+                return key.kind == ResolveKind::Instance;
+            });
+        if (isDelegate && !isInstanceMethod) {
+            if (adapter.callSiteGen.fetchAndAddRelease(1) + 1 == 0)
+                adapter.callSiteGen.fetchAndAddRelease(1);
+        }
+
+        for (const ResolveKey &key : keys) {
+            const auto entry = adapter.resolveCache.find(key);
+            if (entry == adapter.resolveCache.end())
+                continue;
+            const void *funcPtr = entry->funcPtr;
+            if ((isDelegate ? funcPtr : key.objectRef) != ref)
+                continue;
+            adapter.resolveCache.erase(entry);
+            adapter.removeFromIndex(isDelegate ? key.objectRef : funcPtr, key);
+        }
+    }
+
+    void setRefFreedCallback() const
+    {
+        const auto &fnSetCallback = QDOTNETADAPTER_FN(SetRefFreedCallback);
+        if (!fnSetCallback.isValid())
+            return;
+        fnSetCallback(&onRefFreed);
+        refFreedCallbackSet.storeRelease(1);
+    }
+
+    // Layout of the function table filled in by the adapter's Bootstrap() entry point. Entries
+    // point to [UnmanagedCallersOnly] methods of the Qt.DotNet.Adapter+Unmanaged class.
+    struct FunctionTable
+    {
+        static constexpr qint32 Version = 2;
+        qint32 version;
+        qint32 count;
+        void *functions[static_cast<quint32>(Function::Count)];
+    };
+
+    bool bootstrap(QDotNetHost *host)
+    {
+        QDotNetFunction<quint32, void *, qint32> fnBootstrap;
+        if (!host->resolveFunction(fnBootstrap, assemblyPath, typeFullName, "Bootstrap"))
+            return false;
+
+        FunctionTable table{ };
+        if (fnBootstrap(&table, static_cast<qint32>(sizeof(table))) != 0
+            || table.version != FunctionTable::Version) {
+            qWarning() << "QDotNetAdapter: error calling function: Bootstrap";
+            return false;
+        }
+
+        QMutexLocker locker(&resolveMutex);
+        quint64 resolved = 0;
+        const auto setFunction = [&table, &resolved](auto &func, Function id) {
+            const auto idx = static_cast<quint32>(id);
+            if (idx >= static_cast<quint32>(table.count) || table.functions[idx] == nullptr)
+                return;
+            func = table.functions[idx];
+            resolved |= quint64(1) << idx;
+        };
+        setFunction(fnLoadAssembly, Function::LoadAssembly);
+        setFunction(fnResolveStaticMethod, Function::ResolveStaticMethod);
+        setFunction(fnResolveConstructor, Function::ResolveConstructor);
+        setFunction(fnResolveInstanceMethod, Function::ResolveInstanceMethod);
+        setFunction(fnResolveSafeMethod, Function::ResolveSafeMethod);
+        setFunction(fnAddEventHandler, Function::AddEventHandler);
+        setFunction(fnRemoveEventHandler, Function::RemoveEventHandler);
+        setFunction(fnRemoveAllEventHandlers, Function::RemoveAllEventHandlers);
+        setFunction(fnAddObjectRef, Function::AddObjectRef);
+        setFunction(fnFreeDelegateRef, Function::FreeDelegateRef);
+        setFunction(fnFreeObjectRef, Function::FreeObjectRef);
+        setFunction(fnFreeTypeRef, Function::FreeTypeRef);
+        setFunction(fnAddInterfaceProxy, Function::AddInterfaceProxy);
+        setFunction(fnSetInterfaceMethod, Function::SetInterfaceMethod);
+        setFunction(fnStats, Function::Stats);
+        setFunction(fnGetObject, Function::GetObject);
+        setFunction(fnGetGCInfo, Function::GetGCInfo);
+        setFunction(fnStartProfile, Function::StartProfile);
+        setFunction(fnSaveProfile, Function::SaveProfile);
+        setFunction(fnReplayProfile, Function::ReplayProfile);
+        setFunction(fnSetPrepareMode, Function::SetPrepareMode);
+        setFunction(fnGetCounters, Function::GetCounters);
+        setFunction(fnResolveOpenInstanceMethod, Function::ResolveOpenInstanceMethod);
+        setFunction(fnSetRefFreedCallback, Function::SetRefFreedCallback);
+        setFunction(fnGetObjectTypeName, Function::GetObjectTypeName);
+        setFunction(fnRegisterSignature, Function::RegisterSignature);
+        setFunction(fnResolveStaticMethodById, Function::ResolveStaticMethodById);
+        setFunction(fnResolveConstructorById, Function::ResolveConstructorById);
+        setFunction(fnResolveInstanceMethodById, Function::ResolveInstanceMethodById);
+        setFunction(fnResolveOpenInstanceMethodById, Function::ResolveOpenInstanceMethodById);
+        setFunction(fnResolveSafeMethodById, Function::ResolveSafeMethodById);
+        setFunction(fnResolveMany, Function::ResolveMany);
+        resolvedFunctions.fetchAndOrRelease(resolved);
+        return true;
+    }
+
+    template<typename TFunc>
+    const TFunc &resolve(TFunc &func, Function id) const
+    {
+        const quint64 mask = quint64(1) << static_cast<quint32>(id);
+        if (resolvedFunctions.loadAcquire() & mask)
+            return func;
+
+        QMutexLocker locker(&resolveMutex);
+        QDotNetHost *loadedHost = host.loadAcquire();
+        if ((resolvedFunctions.loadRelaxed() & mask) || loadedHost == nullptr)
+            return func;
+        const QString name = QLatin1String(functionNames[static_cast<quint32>(id)]);
+        if (!loadedHost->resolveUnmanagedFunction(func, assemblyPath, unmanagedTypeName, name))
+            qCritical() << "QDotNetAdapter: error resolving function:" << name;
+        else
+            resolvedFunctions.fetchAndOrRelease(mask);
+        return func;
+    }
+
     QDotNetHost defaultHost;
-    mutable QDotNetHost *host = nullptr;
-    mutable QDotNetFunction<bool, QString> fnLoadAssembly;
-    mutable QDotNetFunction<void *, QString, QString, qint32, QList<QDotNetParameter>>
-        fnResolveStaticMethod;
-    mutable QDotNetFunction<void *, qint32, QList<QDotNetParameter>> fnResolveConstructor;
-    mutable QDotNetFunction<void *, QDotNetRef, QString, qint32, QList<QDotNetParameter>>
-        fnResolveInstanceMethod;
-    mutable QDotNetFunction<void *, void *, qint32, QList<QDotNetParameter>> fnResolveSafeMethod;
-    mutable QDotNetFunction<void, QDotNetRef, QString, void *, EventCallback> fnAddEventHandler;
-    mutable QDotNetFunction<void, QDotNetRef, QString, void *> fnRemoveEventHandler;
+    QAtomicPointer<QDotNetHost> host = nullptr;
+    QMutex initMutex;
+    QString assemblyPath;
+    QString typeFullName;
+    QString unmanagedTypeName;
+    mutable QMutex resolveMutex;
+    mutable QAtomicInteger<quint64> resolvedFunctions = 0;
+    // Adapter functions; strings are passed as UTF-16 data and length, booleans as bytes.
+    mutable QDotNetFunction<quint8, QString, qint32> fnLoadAssembly;
+    mutable QDotNetFunction<void *, QString, qint32, QString, qint32, qint32,
+        const QDotNetParameter *> fnResolveStaticMethod;
+    mutable QDotNetFunction<void *, qint32, const QDotNetParameter *> fnResolveConstructor;
+    mutable QDotNetFunction<void *, QDotNetRef, QString, qint32, qint32,
+        const QDotNetParameter *> fnResolveInstanceMethod;
+    mutable QDotNetFunction<void *, void *, qint32, const QDotNetParameter *> fnResolveSafeMethod;
+    mutable QDotNetFunction<void, QDotNetRef, QString, qint32, void *, EventCallback>
+        fnAddEventHandler;
+    mutable QDotNetFunction<void, QDotNetRef, QString, qint32, void *> fnRemoveEventHandler;
     mutable QDotNetFunction<void, QDotNetRef> fnRemoveAllEventHandlers;
-    mutable QDotNetFunction<void *, QDotNetRef, bool> fnAddObjectRef;
+    mutable QDotNetFunction<void *, QDotNetRef, quint8> fnAddObjectRef;
     mutable QDotNetFunction<void, void *> fnFreeDelegateRef;
     mutable QDotNetFunction<void, QDotNetRef> fnFreeObjectRef;
-    mutable QDotNetFunction<void, QString> fnFreeTypeRef;
-    mutable QDotNetFunction<void *, QString> fnAddInterfaceProxy;
-    mutable QDotNetFunction<void, QDotNetRef, QString, qint32, QList<QDotNetParameter>,
+    mutable QDotNetFunction<void, QString, qint32> fnFreeTypeRef;
+    mutable QDotNetFunction<void *, QString, qint32> fnAddInterfaceProxy;
+    mutable QDotNetFunction<void, QDotNetRef, QString, qint32, qint32, QList<QDotNetParameter>,
         void *, void *, void *> fnSetInterfaceMethod;
     mutable QDotNetFunction<void, qint32 *, qint32 *, qint32 *> fnStats;
-    mutable QDotNetFunction<void *, QDotNetRef, QString> fnGetObject;
+    mutable QDotNetFunction<void *, QDotNetRef, QString, qint32> fnGetObject;
+    mutable QDotNetFunction<void, GCInfo *> fnGetGCInfo;
+    mutable QDotNetFunction<void> fnStartProfile;
+    mutable QDotNetFunction<quint8, QString, qint32> fnSaveProfile;
+    mutable QDotNetFunction<qint32, QString, qint32> fnReplayProfile;
+    mutable QDotNetFunction<void, qint32> fnSetPrepareMode;
+    mutable QDotNetFunction<qint32, qint64 *, qint32> fnGetCounters;
+    mutable QDotNetFunction<void *, QString, qint32, QString, qint32, qint32,
+        const QDotNetParameter *> fnResolveOpenInstanceMethod;
+    mutable QDotNetFunction<void, RefFreedCallback> fnSetRefFreedCallback;
+    mutable QDotNetFunction<qint32, QDotNetRef, QChar *, qint32> fnGetObjectTypeName;
+    mutable QDotNetFunction<qint32, qint32, const QDotNetParameter *> fnRegisterSignature;
+    mutable QDotNetFunction<void *, QString, qint32, QString, qint32, qint32, qint32>
+        fnResolveStaticMethodById;
+    mutable QDotNetFunction<void *, qint32, qint32> fnResolveConstructorById;
+    mutable QDotNetFunction<void *, QDotNetRef, QString, qint32, qint32, qint32>
+        fnResolveInstanceMethodById;
+    mutable QDotNetFunction<void *, QString, qint32, QString, qint32, qint32, qint32>
+        fnResolveOpenInstanceMethodById;
+    mutable QDotNetFunction<void *, void *, qint32, qint32> fnResolveSafeMethodById;
+    mutable QDotNetFunction<qint32, QString, qint32, const void *, qint32,
+        const NativeResolveRequest *, void **> fnResolveMany;
+
+    mutable QReadWriteLock resolveCacheLock;
+    mutable QHash<ResolveKey, ResolveEntry> resolveCache;
+    // Keys of cached entries, by function pointer and by object ref.
+    mutable QHash<const void *, QList<ResolveKey>> resolveCacheIndex;
+    mutable QAtomicInteger<quint32> resolveCacheEpoch = 0;
+    mutable QAtomicInteger<qint64> resolveCacheHits = 0;
+    mutable QAtomicInteger<qint64> resolveCacheMisses = 0;
+    mutable QAtomicInteger<quint8> resolveCacheEnabled = 1;
+    mutable QAtomicInteger<quint8> refFreedCallbackSet = 0;
+    mutable QAtomicInteger<quint32> callSiteGen = 1;
+
+    mutable QReadWriteLock signatureLock;
+    // Registered signatures, by signature hash.
+    mutable QHash<quint64, SignatureEntry> signatureIds;
 
     static inline const QString defaultDllName = QLatin1String("Qt.DotNet.Adapter.dll");
     static inline const QString defaultAssemblyName = QLatin1String("Qt.DotNet.Adapter");
     static inline const QString defaultTypeName = QLatin1String("Qt.DotNet.Adapter");
+    static constexpr qsizetype defaultTypeNameSize = 256;
 };
+
+#undef QDOTNETADAPTER_FN
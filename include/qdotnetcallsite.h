@@ -0,0 +1,121 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+#pragma once
+
+#include "qdotnetadapter.h"
+
+#ifdef __GNUC__
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wconversion"
+#endif
+#include <QString>
+#ifdef __GNUC__
+#   pragma GCC diagnostic pop
+#endif
+
+#include <array>
+
+// Inline cache for call sites that resolve methods by name on every call, e.g. QtDotNet::call()
+// and QDotNetObject::call(). The methods most recently resolved are kept, together with the type
+// and method names used to resolve them; calls with the same names reuse them until the adapter
+// reports that they might have been released (see QDotNetAdapter::callSiteGeneration()).
+// Failures to resolve static methods are not cached, as the type might only be found later (e.g.
+// after QDotNetAdapter::loadAssembly()); failures to resolve instance methods are, since the type
+// of the target object is already loaded. Instance methods are resolved as open-instance methods
+// of the target's runtime type, so that a cached method can be invoked on any object of that type.
+// A call site is not thread-safe; call sites are meant to be used as thread-local statics.
+template<typename TResult, typename ...TArg>
+class QDotNetCallSite
+{
+public:
+    using Function = QDotNetFunction<TResult, TArg...>;
+
+    const Function &staticMethod(const QString &typeName, const QString &methodName)
+    {
+        if (const Entry *entry = find(typeName, methodName))
+            return entry->func;
+        const quint32 generation = adapter().callSiteGeneration();
+        const Function func(adapter().resolveStaticMethod(
+            typeName, methodName, QtDotNet::signature<TResult, TArg...>()));
+        if (!func.isValid())
+            return unresolved;
+        return insert(typeName, methodName, generation, func);
+    }
+
+    // Returns an invalid function if the method cannot be resolved as an open-instance method
+    // (e.g. if the method is not accessible); the caller should then fall back to resolving a
+    // closed instance method.
+    const Function &instanceMethod(const QString &typeName, const QString &methodName)
+    {
+        if (const Entry *entry = find(typeName, methodName))
+            return entry->func;
+        const std::array<QDotNetParameter, sizeof...(TArg) + 2> parameters
+        {
+            QDotNetInbound<TResult>::Parameter,
+            QDotNetParameter(typeName, UnmanagedType::ObjectRef),
+            QDotNetOutbound<TArg>::Parameter...
+        };
+        const quint32 generation = adapter().callSiteGeneration();
+        return insert(typeName, methodName, generation, Function(
+            adapter().resolveOpenInstanceMethod(typeName, methodName,
+                QDotNetSignature(parameters)),
+            QDotNetFunctionKind::OpenInstance));
+    }
+
+private:
+    struct Entry
+    {
+        QString typeName;
+        QString methodName;
+        quint32 generation = 0;
+        Function func;
+    };
+
+    // Call sites with the same signature share the same cache, hence more than one entry.
+    static constexpr int EntryCount = 4;
+
+    static const QDotNetAdapter &adapter() { return QDotNetAdapter::instance(); }
+
+    // Names passed from the same QString (e.g. a QStringLiteral at the call site) share their
+    // data with the cached copy, and are matched without comparing characters.
+    static bool sameName(const QString &name, const QString &cachedName)
+    {
+        if (name.constData() == cachedName.constData() && name.size() == cachedName.size())
+            return true;
+        return name == cachedName;
+    }
+
+    const Entry *find(const QString &typeName, const QString &methodName) const
+    {
+        const quint32 generation = adapter().callSiteGeneration();
+        if (generation == 0)
+            return nullptr;
+        for (const Entry &entry : entries) {
+            if (entry.generation == generation
+                && sameName(methodName, entry.methodName)
+                && sameName(typeName, entry.typeName)) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    const Function &insert(const QString &typeName, const QString &methodName,
+        quint32 generation, const Function &func)
+    {
+        Entry &entry = entries[nextEntry];
+        nextEntry = (nextEntry + 1) % EntryCount;
+        entry.typeName = typeName;
+        entry.methodName = methodName;
+        entry.generation = generation;
+        entry.func = func;
+        return entry.func;
+    }
+
+    Entry entries[EntryCount];
+    int nextEntry = 0;
+    Function unresolved;
+};
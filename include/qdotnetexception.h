@@ -42,7 +42,7 @@ public:
     {}
 
     QDotNetException(const QDotNetException &cpySrc)
-        : QDotNetRef(adapter().addObjectRef(&cpySrc))
+        : QDotNetRef(cpySrc)
     {}
 
     QDotNetException &operator =(const QDotNetException &cpySrc)
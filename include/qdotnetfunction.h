@@ -13,31 +13,43 @@
 #   define QDOTNETFUNCTION_CALLTYPE
 #endif
 
+// An open-instance function is not bound to a target object; the target is passed to invoke()
+// and is forwarded to the function as the first argument. Open-instance functions are resolved
+// once per type and shared by all objects of that type (see QDotNetType::instanceMethod()).
+enum class QDotNetFunctionKind
+{
+    Default,
+    OpenInstance
+};
+
 template<typename T, typename... TArg>
 class QDotNetFunction
 {
 public:
-    QDotNetFunction(void *funcPtr = nullptr)
-        : funcPtr(reinterpret_cast<Delegate>(funcPtr))
+    QDotNetFunction(void *funcPtr = nullptr,
+        QDotNetFunctionKind kind = QDotNetFunctionKind::Default)
+        : funcPtr(reinterpret_cast<Delegate>(funcPtr)), kind(kind)
     {}
 
     QDotNetFunction(const QDotNetFunction &cpySrc)
-        : funcPtr(cpySrc.funcPtr)
+        : funcPtr(cpySrc.funcPtr), kind(cpySrc.kind)
     {}
 
     QDotNetFunction &operator=(const QDotNetFunction &cpySrc)
     {
         this->funcPtr = cpySrc.funcPtr;
+        this->kind = cpySrc.kind;
         return *this;
     }
 
     void *ptr() const { return reinterpret_cast<void *>(funcPtr); }
     bool isValid() const { return funcPtr != nullptr; }
+    bool isOpenInstance() const { return kind == QDotNetFunctionKind::OpenInstance; }
 
     typename QDotNetInbound<T>::TargetType operator()(
         typename QDotNetOutbound<TArg>::SourceType... arg) const
     {
-        if (!isValid())
+        if (!isValid() || isOpenInstance())
             return QDotNetNull<T>::value();
         return QDotNetInbound<T>::convert(funcPtr(QDotNetOutbound<TArg>::convert(arg)...));
     }
@@ -45,7 +57,12 @@ public:
     typename QDotNetInbound<T>::TargetType invoke(const QDotNetRef &obj,
         typename QDotNetOutbound<TArg>::SourceType... arg) const
     {
-        return operator()(arg...);
+        if (!isOpenInstance())
+            return operator()(arg...);
+        if (!isValid())
+            return QDotNetNull<T>::value();
+        return QDotNetInbound<T>::convert(reinterpret_cast<OpenDelegate>(funcPtr)(
+            QtDotNet::gcHandle(obj), QDotNetOutbound<TArg>::convert(arg)...));
     }
     typename QDotNetInbound<T>::TargetType invoke(nullptr_t nullObj,
         typename QDotNetOutbound<TArg>::SourceType... arg) const
@@ -56,29 +73,39 @@ public:
 private:
     using Delegate = typename QDotNetInbound<T>::InboundType(QDOTNETFUNCTION_CALLTYPE *)(
         typename QDotNetOutbound<TArg>::OutboundType...);
+    using OpenDelegate = typename QDotNetInbound<T>::InboundType(QDOTNETFUNCTION_CALLTYPE *)(
+        const void *, typename QDotNetOutbound<TArg>::OutboundType...);
     Delegate funcPtr = nullptr;
+    QDotNetFunctionKind kind = QDotNetFunctionKind::Default;
 };
 
 template<typename... TArg>
 class QDotNetFunction<void, TArg...>
 {
 public:
-    QDotNetFunction(void *funcPtr = nullptr)
-        : funcPtr(reinterpret_cast<Delegate>(funcPtr))
+    QDotNetFunction(void *funcPtr = nullptr,
+        QDotNetFunctionKind kind = QDotNetFunctionKind::Default)
+        : funcPtr(reinterpret_cast<Delegate>(funcPtr)), kind(kind)
     {}
 
     void *ptr() const { return reinterpret_cast<void *>(funcPtr); }
     bool isValid() const { return funcPtr != nullptr; }
+    bool isOpenInstance() const { return kind == QDotNetFunctionKind::OpenInstance; }
 
     void operator()(typename QDotNetOutbound<TArg>::SourceType... arg) const
     {
-        if (isValid())
+        if (isValid() && !isOpenInstance())
             funcPtr(QDotNetOutbound<TArg>::convert(arg)...);
     }
 
     void invoke(const QDotNetRef &obj, typename QDotNetOutbound<TArg>::SourceType... arg) const
     {
-        operator()(arg...);
+        if (!isOpenInstance()) {
+            operator()(arg...);
+        } else if (isValid()) {
+            reinterpret_cast<OpenDelegate>(funcPtr)(
+                QtDotNet::gcHandle(obj), QDotNetOutbound<TArg>::convert(arg)...);
+        }
     }
     void invoke(nullptr_t nullObj, typename QDotNetOutbound<TArg>::SourceType... arg) const
     {
@@ -88,5 +115,8 @@ public:
 private:
     using Delegate = void(QDOTNETFUNCTION_CALLTYPE *)(
         typename QDotNetOutbound<TArg>::OutboundType...);
+    using OpenDelegate = void(QDOTNETFUNCTION_CALLTYPE *)(
+        const void *, typename QDotNetOutbound<TArg>::OutboundType...);
     Delegate funcPtr = nullptr;
+    QDotNetFunctionKind kind = QDotNetFunctionKind::Default;
 };
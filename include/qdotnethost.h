@@ -6,59 +6,156 @@
 #pragma once
 
 #include "qdotnetfunction.h"
+#include "qdotnethostoptions.h"
 
 #ifdef __GNUC__
 #   pragma GCC diagnostic push
 #   pragma GCC diagnostic ignored "-Wconversion"
 #endif
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
-#include <QLibrary>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QLibrary>
+#include <QMap>
+#include <QMutexLocker>
 #include <QProcess>
+#include <QPromise>
+#include <QRecursiveMutex>
 #include <QRegularExpression>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
 #include <QString>
 #include <QTemporaryFile>
+#include <QThreadPool>
 #include <QVersionNumber>
 #ifdef __GNUC__
 #   pragma GCC diagnostic pop
 #endif
 
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace QtDotNet
+{
+    // Run func in a thread of the global thread pool; the returned future holds its result.
+    template<typename TFunc>
+    QFuture<bool> runAsync(TFunc func)
+    {
+        auto promise = std::make_shared<QPromise<bool>>();
+        promise->start();
+        QFuture<bool> future = promise->future();
+        QThreadPool::globalInstance()->start([promise, func]() mutable
+        {
+            promise->addResult(func());
+            promise->finish();
+        });
+        return future;
+    }
+}
+
 class QDotNetHost
 {
 public:
     QDotNetHost() = default;
 
+    // Asynchronous loads (see loadAsync()) that have not yet started are cancelled; a load that
+    // is in progress is waited for, as it runs on a pool thread that refers to this object.
     ~QDotNetHost()
     {
+        QList<QFuture<bool>> futures;
+        {
+            QMutexLocker locker(&loadMutex);
+            pendingLoad.reset();
+            futures = std::exchange(loadFutures, {});
+        }
+        for (auto &future : futures)
+            future.waitForFinished();
         unload();
     }
 
-    bool load(const QString& runtimeConfig = defaultRuntimeConfig, const QString &runtimePath = {})
+    // Load the runtime with the given configuration options (see QDotNetHostOptions). Options
+    // that are set are reported by runtimeProperties() once the runtime is loaded. Fails if an
+    // asynchronous load (see loadAsync()) with different options is pending.
+    bool load(const QDotNetHostOptions &options, const QString &runtimePath = {})
     {
         if (isLoaded())
             return true;
-        if (!loadRuntime(runtimePath))
-            return false;
-        if (!init(runtimeConfig)) {
-            unloadRuntime();
+        QMutexLocker locker(&loadMutex);
+        if (hostContext != nullptr)
+            return true;
+        if (!validateOptions(options))
             return false;
-        }
-        return true;
+        return load(loadRequest(options, runtimePath));
+    }
+
+    // Load the runtime with the configuration passed to a pending asynchronous load (see
+    // loadAsync()) or, if there is none, with the default configuration. If a file named
+    // qtdotnet.runtimeconfig.json is deployed next to the application, that file is used instead
+    // of the default configuration.
+    bool load()
+    {
+        QMutexLocker locker(&loadMutex);
+        if (!pendingLoad.has_value())
+            return load(LoadRequest{ defaultRuntimeConfig, {}, {} });
+        const LoadRequest request = *pendingLoad;
+        return load(request);
+    }
+
+    // 'runtimeConfig' is either the JSON contents of a runtime configuration or the path to an
+    // existing runtimeconfig.json file. Fails if an asynchronous load (see loadAsync()) with a
+    // different configuration is pending; otherwise, loading is done by whichever thread gets
+    // there first.
+    bool load(const QString &runtimeConfig, const QString &runtimePath = {})
+    {
+        return load(LoadRequest{ runtimeConfig, runtimePath, {} });
+    }
+
+    // Load the runtime in a background thread. Other threads that need the runtime in the
+    // meantime (e.g. calling load() or resolveFunction()) block until it is loaded. Fails if
+    // another asynchronous load with different options is pending.
+    QFuture<bool> loadAsync(const QDotNetHostOptions &options, const QString &runtimePath = {})
+    {
+        if (isLoaded())
+            return QtDotNet::runAsync([] { return true; });
+        QMutexLocker locker(&loadMutex);
+        if (hostContext != nullptr)
+            return QtDotNet::runAsync([] { return true; });
+        if (!validateOptions(options))
+            return QtDotNet::runAsync([] { return false; });
+        return loadAsync(loadRequest(options, runtimePath));
+    }
+
+    QFuture<bool> loadAsync(const QString &runtimeConfig = defaultRuntimeConfig,
+        const QString &runtimePath = {})
+    {
+        return loadAsync(LoadRequest{ runtimeConfig, runtimePath, {} });
     }
 
     void unload()
     {
-        if (!isLoaded())
+        QMutexLocker locker(&loadMutex);
+        pendingLoad.reset();
+        if (hostContext == nullptr)
             return;
+        loaded.store(false, std::memory_order_release);
+        runtimeEnvironment.clear();
         close();
         unloadRuntime();
     }
 
+    // Does not block while the runtime is being loaded (e.g. by loadAsync()).
     bool isLoaded() const
     {
-        return (hostContext != nullptr);
+        return loaded.load(std::memory_order_acquire);
     }
 
     bool resolveFunction(QDotNetFunction<quint32, void *, qint32> &outFunc,
@@ -77,9 +174,25 @@ public:
         return outFunc.isValid();
     }
 
+    // Resolve a static method marked with [UnmanagedCallersOnly]. The method is called directly,
+    // without a marshaling stub, so the signature of 'outFunc' must only use blittable types.
+    template<typename TResult, typename... TArgs>
+    bool resolveUnmanagedFunction(QDotNetFunction<TResult, TArgs...> &outFunc,
+        const QString &assemblyPath, const QString &typeName, const QString &methodName)
+    {
+        if (!isLoaded() && !load())
+            return false;
+        outFunc = resolveFunction(assemblyPath, typeName, methodName,
+            UNMANAGEDCALLERSONLY_METHOD);
+        return outFunc.isValid();
+    }
+
+    // Also includes the settings read from environment variables (e.g. DOTNET_ReadyToRun, see
+    // QDotNetHostOptions::environment()), with the values in effect when the runtime was loaded.
     QMap<QString, QString> runtimeProperties() const
     {
-        if (!isLoaded())
+        QMutexLocker locker(&loadMutex);
+        if (hostContext == nullptr)
             return {};
         size_t queryCount = 0;
         const auto result = fnAllRuntimeProperties(hostContext, &queryCount, nullptr, nullptr);
@@ -105,12 +218,14 @@ public:
         }
         delete[] keys;
         delete[] values;
+        properties.insert(runtimeEnvironment);
         return properties;
     }
 
     QString runtimeProperty(const QString &name) const
     {
-        if (!isLoaded())
+        QMutexLocker locker(&loadMutex);
+        if (hostContext == nullptr)
             return {};
         const char_t *value = nullptr;
         if (HOSTFN_FAILED(fnRuntimeProperty(hostContext, STR(name), &value))) {
@@ -124,7 +239,8 @@ public:
 
     bool setRuntimeProperty(const QString &name, const QString &value) const
     {
-        if (!isLoaded())
+        QMutexLocker locker(&loadMutex);
+        if (hostContext == nullptr)
             return false;
         if (HOSTFN_FAILED(fnSetRuntimeProperty(hostContext, STR(name), STR(value)))) {
             qCritical() << "Error calling function: hostfxr_set_runtime_property_value";
@@ -133,25 +249,136 @@ public:
         return true;
     }
 
+    // Time spent (in nanoseconds) in each phase of the last call to load().
+    // "findRuntime" is only present if the hostfxr path was not given by the caller, and is
+    // included in "loadRuntime".
+    QMap<QString, qint64> startupTimings() const
+    {
+        QMutexLocker locker(&loadMutex);
+        return timings;
+    }
+
     void setErrorWriter(hostfxr_error_writer_fn errorWriter)
     {
+        QMutexLocker locker(&loadMutex);
         if (fnSetErrorWriter == nullptr || hostContext == nullptr)
             return;
         fnSetErrorWriter(errorWriter);
     }
 
 private:
+    // Configuration and environment variables to load the runtime with.
+    struct LoadRequest
+    {
+        QString runtimeConfig;
+        QString runtimePath;
+        QMap<QString, QString> environment;
+
+        bool operator==(const LoadRequest &other) const
+        {
+            return runtimeConfig == other.runtimeConfig && runtimePath == other.runtimePath
+                && environment == other.environment;
+        }
+    };
+
+    static LoadRequest loadRequest(const QDotNetHostOptions &options, const QString &runtimePath)
+    {
+        return LoadRequest{ options.isDefault() ? defaultRuntimeConfig : options.runtimeConfig(),
+            runtimePath, options.environment() };
+    }
+
+    bool load(const LoadRequest &request)
+    {
+        QMutexLocker locker(&loadMutex);
+        if (hostContext != nullptr)
+            return true;
+        if (conflictsWithPendingLoad(request))
+            return false;
+        pendingLoad.reset();
+        // Only the thread that loads the runtime sets its environment, while holding the lock.
+        const auto &environment = request.environment;
+        for (auto var = environment.constBegin(); var != environment.constEnd(); ++var)
+            qputenv(var.key().toLocal8Bit(), var.value().toLocal8Bit());
+        timings.clear();
+        QElapsedTimer timer;
+        timer.start();
+        if (!loadRuntime(request.runtimePath))
+            return false;
+        timings.insert("loadRuntime", timer.nsecsElapsed());
+        timer.restart();
+        if (!init(request.runtimeConfig)) {
+            unloadRuntime();
+            return false;
+        }
+        timings.insert("initRuntime", timer.nsecsElapsed());
+        runtimeEnvironment = QDotNetHostOptions::defaultEnvironment();
+        for (auto var = runtimeEnvironment.begin(); var != runtimeEnvironment.end(); ++var)
+            *var = qEnvironmentVariable(var.key().toLocal8Bit().constData(), *var);
+        loaded.store(true, std::memory_order_release);
+        return true;
+    }
+
+    QFuture<bool> loadAsync(const LoadRequest &request)
+    {
+        QMutexLocker locker(&loadMutex);
+        if (hostContext != nullptr)
+            return QtDotNet::runAsync([] { return true; });
+        if (conflictsWithPendingLoad(request))
+            return QtDotNet::runAsync([] { return false; });
+        pendingLoad = request;
+        // The pending load is cancelled if the host is unloaded before it starts
+        const QFuture<bool> future = QtDotNet::runAsync([this]
+        {
+            QMutexLocker locker(&loadMutex);
+            return pendingLoad.has_value() ? load() : (hostContext != nullptr);
+        });
+        loadFutures.removeIf([](const QFuture<bool> &x) { return x.isFinished(); });
+        loadFutures.append(future);
+        return future;
+    }
+
+    bool conflictsWithPendingLoad(const LoadRequest &request) const
+    {
+        QMutexLocker locker(&loadMutex);
+        if (!pendingLoad.has_value() || *pendingLoad == request)
+            return false;
+        qCritical() << "QDotNetHost: an asynchronous load with different options is pending";
+        return true;
+    }
+
+    static bool validateOptions(const QDotNetHostOptions &options)
+    {
+        const QStringList errors = options.validate();
+        if (errors.isEmpty())
+            return true;
+        qCritical() << "QDotNetHost: invalid options:" << errors;
+        return false;
+    }
+
     void *resolveFunction(const QString &assemblyPath, const QString &typeName,
         const QString &methodName, const QString &delegateType) const
     {
-        if (hostContext == nullptr)
+        if (delegateType.isEmpty())
+            return resolveFunction(assemblyPath, typeName, methodName, nullptr);
+        return resolveFunction(assemblyPath, typeName, methodName, STR(delegateType));
+    }
+
+    void *resolveFunction(const QString &assemblyPath, const QString &typeName,
+        const QString &methodName, const char_t *delegateType) const
+    {
+        load_assembly_and_get_function_pointer_fn fnLoadAssembly = nullptr;
+        {
+            QMutexLocker locker(&loadMutex);
+            fnLoadAssembly = fnLoadAssemblyAndGetFunctionPointer;
+        }
+        if (fnLoadAssembly == nullptr)
             return nullptr;
         void *funcPtr = nullptr;
-        auto result = fnLoadAssemblyAndGetFunctionPointer(
+        auto result = fnLoadAssembly(
             STR(assemblyPath),
             STR(typeName),
             STR(methodName),
-            delegateType.isEmpty() ? nullptr : STR(delegateType),
+            delegateType,
             nullptr,
             &funcPtr);
         if (HOSTFN_FAILED(result)) {
@@ -163,6 +390,91 @@ private:
     }
 
     QString findRuntimePath() const
+    {
+        const QString dotNetRoot = qEnvironmentVariable("DOTNET_ROOT");
+
+        QString runtimePath = readProbeCache(dotNetRoot);
+        if (!runtimePath.isEmpty())
+            return runtimePath;
+
+        runtimePath = findRuntimePathNetHost();
+        if (runtimePath.isEmpty())
+            runtimePath = findRuntimePathInstallDir(dotNetRoot);
+        if (runtimePath.isEmpty())
+            runtimePath = findRuntimePathDotNetInfo();
+        if (runtimePath.isEmpty())
+            return {};
+
+        writeProbeCache(dotNetRoot, runtimePath);
+        return runtimePath;
+    }
+
+    static QString findRuntimePathNetHost()
+    {
+        QLibrary nethost(QDir(QCoreApplication::applicationDirPath()).filePath("nethost"));
+        if (!nethost.load()) {
+            nethost.setFileName("nethost");
+            if (!nethost.load())
+                return {};
+        }
+
+        const auto fnGetHostFxrPath = GET_FN(nethost, get_hostfxr_path_fn);
+        if (!fnGetHostFxrPath) {
+            qWarning() << "Error loading function: get_hostfxr_path";
+            return {};
+        }
+
+        size_t bufferSize = 0;
+        auto result = fnGetHostFxrPath(nullptr, &bufferSize, nullptr);
+        if (result != HostApiBufferTooSmall || bufferSize == 0)
+            return {};
+
+        QList<char_t> buffer(static_cast<qsizetype>(bufferSize));
+        result = fnGetHostFxrPath(buffer.data(), &bufferSize, nullptr);
+        if (HOSTFN_FAILED(result)) {
+            qWarning() << "Error calling function: get_hostfxr_path";
+            return {};
+        }
+        const QString runtimePath = QSTR(buffer.constData());
+        if (!QFile::exists(runtimePath))
+            return {};
+        return runtimePath;
+    }
+
+    static QString findRuntimePathInstallDir(const QString &dotNetRoot)
+    {
+        QStringList installDirs;
+        if (!dotNetRoot.isEmpty())
+            installDirs.append(dotNetRoot);
+#ifdef Q_OS_WINDOWS
+        installDirs.append(QDir(qEnvironmentVariable("ProgramFiles")).filePath("dotnet"));
+#else
+        installDirs.append(QStringLiteral("/usr/share/dotnet"));
+        installDirs.append(QStringLiteral("/usr/lib/dotnet"));
+        installDirs.append(QStringLiteral("/usr/local/share/dotnet"));
+#endif
+        for (const QString &installDir : installDirs) {
+            QDir fxrDir(installDir);
+            if (!fxrDir.cd("host/fxr"))
+                continue;
+
+            QVersionNumber maxVersion;
+            QString runtimePath = {};
+            for (const QString &version : fxrDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+                const QString path = QDir(fxrDir.filePath(version)).absoluteFilePath(hostFxrName);
+                const auto versionNumber = QVersionNumber::fromString(version);
+                if (versionNumber > maxVersion && QFile::exists(path)) {
+                    maxVersion = versionNumber;
+                    runtimePath = path;
+                }
+            }
+            if (!runtimePath.isEmpty())
+                return runtimePath;
+        }
+        return {};
+    }
+
+    static QString findRuntimePathDotNetInfo()
     {
         QProcess procDotNetInfo;
         procDotNetInfo.start("dotnet", { "--list-runtimes" });
@@ -202,11 +514,7 @@ private:
             qCritical() << "Error dotnet host fxr directory not found";
             return {};
         }
-#ifdef Q_OS_WINDOWS
-        QString runtimePath = runtimeDir.absoluteFilePath("hostfxr.dll");
-#else
-        QString runtimePath = runtimeDir.absoluteFilePath("libhostfxr.so");
-#endif
+        QString runtimePath = runtimeDir.absoluteFilePath(hostFxrName);
         if (!QFile::exists(runtimePath)) {
             qCritical() << "Error dotnet host fxr dll not found";
             return {};
@@ -214,6 +522,66 @@ private:
         return runtimePath;
     }
 
+    static QString cacheDirPath()
+    {
+        const QString cacheDir = QStandardPaths::writableLocation(
+            QStandardPaths::GenericCacheLocation);
+        if (cacheDir.isEmpty())
+            return {};
+        return QDir(cacheDir).filePath(cacheDirName);
+    }
+
+    // The probe cache stores the last hostfxr path that was found, together with the values it
+    // depends on: the DOTNET_ROOT variable and the modification time of the host/fxr directory,
+    // which changes whenever a runtime version is installed or removed.
+    static QString probeCacheFilePath()
+    {
+        const QString cacheDir = cacheDirPath();
+        if (cacheDir.isEmpty())
+            return {};
+        return QDir(cacheDir).filePath(probeCacheFileName);
+    }
+
+    static qint64 fxrDirModified(const QString &runtimePath)
+    {
+        QDir fxrDir = QFileInfo(runtimePath).dir();
+        if (!fxrDir.cdUp())
+            return 0;
+        return QFileInfo(fxrDir.absolutePath()).lastModified().toMSecsSinceEpoch();
+    }
+
+    static QString readProbeCache(const QString &dotNetRoot)
+    {
+        const QString cacheFilePath = probeCacheFilePath();
+        if (cacheFilePath.isEmpty() || !QFile::exists(cacheFilePath))
+            return {};
+
+        const QSettings cache(cacheFilePath, QSettings::IniFormat);
+        if (cache.value("hostfxr/dotnetRoot").toString() != dotNetRoot)
+            return {};
+        const QString runtimePath = cache.value("hostfxr/path").toString();
+        if (runtimePath.isEmpty() || !QFile::exists(runtimePath))
+            return {};
+        if (cache.value("hostfxr/modified").toLongLong() != fxrDirModified(runtimePath))
+            return {};
+        return runtimePath;
+    }
+
+    static void writeProbeCache(const QString &dotNetRoot, const QString &runtimePath)
+    {
+        const QString cacheFilePath = probeCacheFilePath();
+        if (cacheFilePath.isEmpty() || !QDir().mkpath(cacheDirPath()))
+            return;
+
+        QSettings cache(cacheFilePath, QSettings::IniFormat);
+        cache.setValue("hostfxr/dotnetRoot", dotNetRoot);
+        cache.setValue("hostfxr/path", runtimePath);
+        cache.setValue("hostfxr/modified", fxrDirModified(runtimePath));
+        cache.sync();
+        if (cache.status() != QSettings::NoError)
+            qWarning() << "Error writing file:" << cacheFilePath;
+    }
+
     bool loadRuntime(const QString & runtimePath)
     {
         if (fnInitHost != nullptr)
@@ -224,7 +592,10 @@ private:
                 return false;
             runtime.setFileName(runtimePath);
         } else {
+            QElapsedTimer timer;
+            timer.start();
             const QString defaultRuntimePath = findRuntimePath();
+            timings.insert("findRuntime", timer.nsecsElapsed());
             if (defaultRuntimePath.isEmpty())
                 return false;
             runtime.setFileName(defaultRuntimePath);
@@ -297,22 +668,21 @@ private:
         if (fnInitHost == nullptr)
             return false;
 
-        const QString tempFileName = writeTempFile(runtimeConfig, runtimeConfigFileName);
-        if (tempFileName.isEmpty()) {
+        bool isTempFile = false;
+        const QString runtimeConfigPath = findRuntimeConfig(runtimeConfig, &isTempFile);
+        if (runtimeConfigPath.isEmpty()) {
             qCritical() << "Error writing runtime configuration file.";
             return false;
         }
 
-        auto result = fnInitHost(STR(tempFileName), nullptr, &hostContext);
+        auto result = fnInitHost(STR(runtimeConfigPath), nullptr, &hostContext);
+        if (isTempFile && !QFile::remove(runtimeConfigPath))
+            qWarning() << "Error removing file:" << runtimeConfigPath;
         if (HOSTFN_FAILED(result) || hostContext == nullptr) {
             qCritical() << "Error calling function: hostfxr_initialize_for_runtime_config";
-            QFile::remove(tempFileName);
             return false;
         }
 
-        if (!QFile::remove(tempFileName))
-            qWarning() << "Error removing file:" << tempFileName;
-
         result = fnGetRuntimeDelegate(hostContext,
             hdt_load_assembly_and_get_function_pointer,
             reinterpret_cast<void **>(&fnLoadAssemblyAndGetFunctionPointer));
@@ -325,6 +695,49 @@ private:
         return true;
     }
 
+    // Locate a runtime configuration file without writing to the file system, if possible:
+    //  * 'runtimeConfig' is the path to an existing file;
+    //  * the default configuration was requested and a prebuilt file is deployed next to the
+    //    application executable (see prebuiltRuntimeConfigFileName);
+    //  * a file with the same contents was written to the cache location by a previous run
+    //    (the file name includes a hash of the contents).
+    // Otherwise, the configuration is written to the cache location or, as a last resort, to a
+    // temporary file which the caller must remove.
+    static QString findRuntimeConfig(const QString &runtimeConfig, bool *isTempFile)
+    {
+        *isTempFile = false;
+        if (!runtimeConfig.trimmed().startsWith('{') && QFile::exists(runtimeConfig))
+            return runtimeConfig;
+
+        if (runtimeConfig == defaultRuntimeConfig) {
+            const QString prebuiltPath = QDir(QCoreApplication::applicationDirPath())
+                .filePath(prebuiltRuntimeConfigFileName);
+            if (QFile::exists(prebuiltPath))
+                return prebuiltPath;
+        }
+
+        const QByteArray fileData = runtimeConfig.toUtf8();
+        const QString cacheDir = cacheDirPath();
+        if (!cacheDir.isEmpty()) {
+            const QString cachedPath = QDir(cacheDir).filePath(runtimeConfigCacheFileName.arg(
+                QString::fromLatin1(
+                    QCryptographicHash::hash(fileData, QCryptographicHash::Sha1).toHex())));
+            if (QFile::exists(cachedPath))
+                return cachedPath;
+            if (QDir().mkpath(cacheDir)) {
+                QSaveFile cachedFile(cachedPath);
+                if (cachedFile.open(QIODevice::WriteOnly)
+                    && cachedFile.write(fileData) == fileData.size() && cachedFile.commit()) {
+                    return cachedPath;
+                }
+            }
+            qWarning() << "Error writing file:" << cachedPath;
+        }
+
+        *isTempFile = true;
+        return writeTempFile(runtimeConfig, runtimeConfigFileName);
+    }
+
     bool close()
     {
         if (fnCloseHost == nullptr || hostContext == nullptr)
@@ -362,6 +775,17 @@ private:
     }
 
     static inline const QString runtimeConfigFileName = QStringLiteral("runtimeconfig.XXXXXX.json");
+    static inline const QString prebuiltRuntimeConfigFileName
+        = QStringLiteral("qtdotnet.runtimeconfig.json");
+    static inline const QString runtimeConfigCacheFileName
+        = QStringLiteral("runtimeconfig.%1.json");
+    static inline const QString cacheDirName = QStringLiteral("qtdotnet");
+    static inline const QString probeCacheFileName = QStringLiteral("probe.ini");
+#ifdef Q_OS_WINDOWS
+    static inline const QString hostFxrName = QStringLiteral("hostfxr.dll");
+#else
+    static inline const QString hostFxrName = QStringLiteral("libhostfxr.so");
+#endif
     static inline const QString defaultRuntimeConfig = QStringLiteral(R"[json](
 {
   "runtimeOptions": {
@@ -389,6 +813,12 @@ private:
     hostfxr_get_runtime_property_value_fn fnRuntimeProperty = nullptr;
     hostfxr_set_runtime_property_value_fn fnSetRuntimeProperty = nullptr;
     hostfxr_handle hostContext = nullptr;
+    QMap<QString, qint64> timings;
+    mutable QRecursiveMutex loadMutex;
+    std::optional<LoadRequest> pendingLoad;
+    QMap<QString, QString> runtimeEnvironment;
+    QList<QFuture<bool>> loadFutures;
+    std::atomic<bool> loaded = false;
 
     load_assembly_and_get_function_pointer_fn fnLoadAssemblyAndGetFunctionPointer = nullptr;
 };
@@ -179,6 +179,10 @@ using hostfxr_close_fn = quint32(HOSTFXR_CALLTYPE *)(hostfxr_handle host_context
 #   define CORECLR_DELEGATE_CALLTYPE
 #endif
 
+// Signals to the runtime that the function being requested is marked with
+// [UnmanagedCallersOnly] and that no delegate type must be looked up.
+#define UNMANAGEDCALLERSONLY_METHOD ((const char_t *)-1)
+
 using component_entry_point_fn = quint32(CORECLR_DELEGATE_CALLTYPE *)(
     void *arg, qint32 arg_size_in_bytes);
 
@@ -0,0 +1,299 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+#pragma once
+
+#ifdef __GNUC__
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wconversion"
+#endif
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#ifdef __GNUC__
+#   pragma GCC diagnostic pop
+#endif
+
+#include <limits>
+#include <optional>
+
+// Runtime configuration options for QDotNetHost::load(). Options that are not set are left out
+// of the generated runtime configuration, i.e. the .NET runtime defaults apply.
+class QDotNetHostOptions
+{
+public:
+    enum class Profile
+    {
+        // .NET runtime defaults.
+        Default,
+        // Minimize start-up time: tiered compilation with quick JIT (also for methods with
+        // loops), use of ReadyToRun code, no dynamic PGO and invariant globalization (i.e. no
+        // loading of ICU libraries).
+        FastStartup,
+        // Maximize steady-state performance: tiered compilation with dynamic PGO, fully
+        // optimized JIT for methods with loops and no use of ReadyToRun code, so that all code
+        // is eventually re-compiled with profile data.
+        PeakThroughput
+    };
+
+    QDotNetHostOptions(Profile profile = Profile::Default)
+    {
+        setProfile(profile);
+    }
+
+    void setProfile(Profile profile)
+    {
+        switch (profile) {
+        case Profile::Default:
+            break;
+        case Profile::FastStartup:
+            setTieredCompilation(true);
+            setQuickJit(true);
+            setQuickJitForLoops(true);
+            setTieredPGO(false);
+            setReadyToRun(true);
+            setInvariantGlobalization(true);
+            break;
+        case Profile::PeakThroughput:
+            setTieredCompilation(true);
+            setQuickJit(true);
+            setQuickJitForLoops(false);
+            setTieredPGO(true);
+            setReadyToRun(false);
+            break;
+        }
+    }
+
+    void setTieredCompilation(bool enabled) { setConfigProperty(TieredCompilation, enabled); }
+    std::optional<bool> tieredCompilation() const { return boolProperty(TieredCompilation); }
+
+    void setQuickJit(bool enabled) { setConfigProperty(QuickJit, enabled); }
+    std::optional<bool> quickJit() const { return boolProperty(QuickJit); }
+
+    void setQuickJitForLoops(bool enabled) { setConfigProperty(QuickJitForLoops, enabled); }
+    std::optional<bool> quickJitForLoops() const { return boolProperty(QuickJitForLoops); }
+
+    void setTieredPGO(bool enabled) { setConfigProperty(TieredPGO, enabled); }
+    std::optional<bool> tieredPGO() const { return boolProperty(TieredPGO); }
+
+    void setInvariantGlobalization(bool enabled)
+    {
+        setConfigProperty(InvariantGlobalization, enabled);
+    }
+    std::optional<bool> invariantGlobalization() const
+    {
+        return boolProperty(InvariantGlobalization);
+    }
+
+    // Garbage collector: server (one heap and GC thread per core) vs. workstation GC.
+    void setServerGC(bool enabled) { setConfigProperty(ServerGC, enabled); }
+    std::optional<bool> serverGC() const { return boolProperty(ServerGC); }
+
+    // Garbage collector: background (concurrent) collection of gen. 2 objects.
+    void setConcurrentGC(bool enabled) { setConfigProperty(ConcurrentGC, enabled); }
+    std::optional<bool> concurrentGC() const { return boolProperty(ConcurrentGC); }
+
+    // Garbage collector: maximum commit size for the GC heap, in bytes.
+    void setHeapHardLimit(quint64 bytes) { setConfigProperty(HeapHardLimit, hexValue(bytes)); }
+    std::optional<quint64> heapHardLimit() const { return uint64Property(HeapHardLimit); }
+
+    // Garbage collector: processors to use for server GC heaps and threads (bitmask).
+    void setHeapAffinitizeMask(quint64 mask)
+    {
+        setConfigProperty(HeapAffinitizeMask, hexValue(mask));
+    }
+    std::optional<quint64> heapAffinitizeMask() const
+    {
+        return uint64Property(HeapAffinitizeMask);
+    }
+
+    // Garbage collector: compact the heap more aggressively, at the expense of longer pauses.
+    // Level is 0 (disabled) to 9 (most aggressive).
+    void setConserveMemory(int level) { setConfigProperty(ConserveMemory, level); }
+    std::optional<int> conserveMemory() const
+    {
+        const auto level = uint64Property(ConserveMemory);
+        if (!level.has_value())
+            return std::nullopt;
+        // Out-of-range levels are reported by validate()
+        return static_cast<int>(qMin<quint64>(*level, std::numeric_limits<int>::max()));
+    }
+
+    // Garbage collector: keep freed segments for future use instead of releasing them to the OS.
+    void setRetainVM(bool enabled) { setConfigProperty(RetainVM, enabled); }
+    std::optional<bool> retainVM() const { return boolProperty(RetainVM); }
+
+    // The use of ReadyToRun (precompiled) code cannot be set in the runtime configuration; it is
+    // set through the DOTNET_ReadyToRun environment variable when the runtime is loaded. The
+    // effective value is reported by QDotNetHost::runtimeProperties() under the variable name.
+    void setReadyToRun(bool enabled) { readyToRunEnabled = enabled; }
+    std::optional<bool> readyToRun() const { return readyToRunEnabled; }
+
+    // Directory where code generated for interop calls is saved and loaded from, so that code
+    // generated in a previous run is not generated again (unless the target assembly is rebuilt).
+    // The cache is disabled by default.
+    void setCodeCacheDirectory(const QString &path)
+    {
+        setConfigProperty(CodeCacheDirectory, path.isEmpty() ? QJsonValue() : QJsonValue(path));
+    }
+    QString codeCacheDirectory() const { return properties.value(CodeCacheDirectory).toString(); }
+
+    // Any other runtime configuration knob, e.g. "System.Threading.ThreadPool.MinThreads".
+    void setConfigProperty(const QString &name, const QJsonValue &value)
+    {
+        if (value.isUndefined() || value.isNull())
+            properties.remove(name);
+        else
+            properties.insert(name, value);
+    }
+    QJsonValue configProperty(const QString &name) const { return properties.value(name); }
+    QJsonObject configProperties() const { return properties; }
+
+    // Default values of the environment variables that environment() might set.
+    static QMap<QString, QString> defaultEnvironment()
+    {
+        return { { ReadyToRunVariable, QStringLiteral("1") } };
+    }
+
+    // Environment variables to set before loading the runtime.
+    QMap<QString, QString> environment() const
+    {
+        QMap<QString, QString> env;
+        if (readyToRunEnabled.has_value())
+            env.insert(ReadyToRunVariable, *readyToRunEnabled ? "1" : "0");
+        return env;
+    }
+
+    bool isDefault() const
+    {
+        return properties.isEmpty() && environment().isEmpty();
+    }
+
+    // Returns a list of errors, or an empty list if the options are valid.
+    QStringList validate() const
+    {
+        QStringList errors;
+        for (auto prop = properties.constBegin(); prop != properties.constEnd(); ++prop) {
+            if (prop.key().trimmed().isEmpty())
+                errors.append(QStringLiteral("Empty configuration property name"));
+            else if (prop.value().isObject() || prop.value().isArray())
+                errors.append(QStringLiteral("Invalid value for %1").arg(prop.key()));
+        }
+        for (const QString &name : { TieredCompilation, QuickJit, QuickJitForLoops, TieredPGO,
+            InvariantGlobalization, ServerGC, ConcurrentGC, RetainVM }) {
+            if (properties.contains(name) && !properties.value(name).isBool())
+                errors.append(QStringLiteral("%1 must be a boolean").arg(name));
+        }
+        for (const QString &name : { HeapHardLimit, HeapAffinitizeMask, ConserveMemory }) {
+            if (properties.contains(name) && !uint64Property(name).has_value())
+                errors.append(QStringLiteral("%1 must be a non-negative integer").arg(name));
+        }
+        if (properties.contains(CodeCacheDirectory)
+            && properties.value(CodeCacheDirectory).toString().isEmpty()) {
+            errors.append(QStringLiteral("%1 must be a path").arg(CodeCacheDirectory));
+        }
+        if (tieredCompilation() == false) {
+            if (tieredPGO() == true)
+                errors.append(QStringLiteral("TieredPGO requires TieredCompilation"));
+            if (quickJit() == true)
+                errors.append(QStringLiteral("QuickJit requires TieredCompilation"));
+            if (quickJitForLoops() == true)
+                errors.append(QStringLiteral("QuickJitForLoops requires TieredCompilation"));
+        }
+        if (quickJit() == false && quickJitForLoops() == true)
+            errors.append(QStringLiteral("QuickJitForLoops requires QuickJit"));
+        if (heapHardLimit() == 0u)
+            errors.append(QStringLiteral("HeapHardLimit must be greater than zero"));
+        if (heapAffinitizeMask().has_value() && serverGC() != true)
+            errors.append(QStringLiteral("HeapAffinitizeMask requires ServerGC"));
+        if (heapAffinitizeMask() == 0u)
+            errors.append(QStringLiteral("HeapAffinitizeMask must select at least one processor"));
+        if (uint64Property(ConserveMemory) > 9u)
+            errors.append(QStringLiteral("ConserveMemory must be between 0 and 9"));
+        return errors;
+    }
+
+    bool isValid() const { return validate().isEmpty(); }
+
+    // Contents of a runtimeconfig.json file with the current options.
+    QString runtimeConfig() const
+    {
+        QJsonObject runtimeOptions{
+            { "tfm", targetFramework },
+            { "rollForward", rollForward },
+            { "framework", QJsonObject{
+                { "name", frameworkName },
+                { "version", frameworkVersion } } }
+        };
+        if (!properties.isEmpty())
+            runtimeOptions.insert("configProperties", properties);
+        const QJsonObject config{ { "runtimeOptions", runtimeOptions } };
+        return QString::fromUtf8(QJsonDocument(config).toJson(QJsonDocument::Indented));
+    }
+
+    static inline const QString TieredCompilation
+        = QStringLiteral("System.Runtime.TieredCompilation");
+    static inline const QString QuickJit
+        = QStringLiteral("System.Runtime.TieredCompilation.QuickJit");
+    static inline const QString QuickJitForLoops
+        = QStringLiteral("System.Runtime.TieredCompilation.QuickJitForLoops");
+    static inline const QString TieredPGO = QStringLiteral("System.Runtime.TieredPGO");
+    static inline const QString InvariantGlobalization
+        = QStringLiteral("System.Globalization.Invariant");
+    static inline const QString ServerGC = QStringLiteral("System.GC.Server");
+    static inline const QString ConcurrentGC = QStringLiteral("System.GC.Concurrent");
+    static inline const QString HeapHardLimit = QStringLiteral("System.GC.HeapHardLimit");
+    static inline const QString HeapAffinitizeMask
+        = QStringLiteral("System.GC.HeapAffinitizeMask");
+    static inline const QString ConserveMemory = QStringLiteral("System.GC.ConserveMemory");
+    static inline const QString RetainVM = QStringLiteral("System.GC.RetainVM");
+    static inline const QString CodeCacheDirectory = QStringLiteral("Qt.DotNet.CodeCache");
+    static inline const QString ReadyToRunVariable = QStringLiteral("DOTNET_ReadyToRun");
+
+private:
+    std::optional<bool> boolProperty(const QString &name) const
+    {
+        const QJsonValue value = properties.value(name);
+        if (!value.isBool())
+            return std::nullopt;
+        return value.toBool();
+    }
+
+    // 64-bit values are written as hex strings, which the runtime accepts for GC settings, since
+    // JSON numbers are doubles, i.e. only exact up to 2^53; such numbers are also accepted.
+    static QJsonValue hexValue(quint64 value)
+    {
+        return QStringLiteral("0x%1").arg(value, 0, 16);
+    }
+
+    std::optional<quint64> uint64Property(const QString &name) const
+    {
+        const QJsonValue value = properties.value(name);
+        if (value.isString()) {
+            bool ok = false;
+            const quint64 number = value.toString().toULongLong(&ok, 0);
+            if (!ok)
+                return std::nullopt;
+            return number;
+        }
+        constexpr double maxExactInteger = 9007199254740992.0; // 2^53
+        if (!value.isDouble() || value.toDouble() < 0 || value.toDouble() > maxExactInteger
+            || value.toDouble() != static_cast<double>(value.toInteger())) {
+            return std::nullopt;
+        }
+        return static_cast<quint64>(value.toInteger());
+    }
+
+    QJsonObject properties;
+    std::optional<bool> readyToRunEnabled;
+
+    static inline const QString targetFramework = QStringLiteral("net6.0");
+    static inline const QString rollForward = QStringLiteral("LatestMinor");
+    static inline const QString frameworkName = QStringLiteral("Microsoft.NETCore.App");
+    static inline const QString frameworkVersion = QStringLiteral("6.0.0");
+};
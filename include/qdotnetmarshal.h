@@ -18,32 +18,34 @@
 #   pragma GCC diagnostic pop
 #endif
 
+#include <iterator>
 #include <type_traits>
 
 class QDotNetException;
 class QDotNetRef;
 class QDotNetType;
 
+// Type names are UTF-16 literals, so that they can be passed to the adapter without conversion.
 namespace QtDotNet::TypeNames::System
 {
-    static constexpr char Void[]{ "System.Void" };
-    static constexpr char Boolean[]{ "System.Boolean" };
-    static constexpr char Single[]{ "System.Single" };
-    static constexpr char Double[]{ "System.Double" };
-    static constexpr char Byte[]{ "System.Byte" };
-    static constexpr char SByte[]{ "System.SByte" };
-    static constexpr char Int16[]{ "System.Int16" };
-    static constexpr char UInt16[]{ "System.UInt16" };
-    static constexpr char Int32[]{ "System.Int32" };
-    static constexpr char UInt32[]{ "System.UInt32" };
-    static constexpr char Int64[]{ "System.Int64" };
-    static constexpr char UInt64[]{ "System.UInt64" };
-    static constexpr char IntPtr[]{ "System.IntPtr" };
-    static constexpr char UIntPtr[]{ "System.UIntPtr" };
-    static constexpr char Char[]{ "System.Char" };
-    static constexpr char String[]{ "System.String" };
-    static constexpr char Object[]{ "System.Object" };
-    static constexpr char Type[]{ "System.Type" };
+    static constexpr char16_t Void[]{ u"System.Void" };
+    static constexpr char16_t Boolean[]{ u"System.Boolean" };
+    static constexpr char16_t Single[]{ u"System.Single" };
+    static constexpr char16_t Double[]{ u"System.Double" };
+    static constexpr char16_t Byte[]{ u"System.Byte" };
+    static constexpr char16_t SByte[]{ u"System.SByte" };
+    static constexpr char16_t Int16[]{ u"System.Int16" };
+    static constexpr char16_t UInt16[]{ u"System.UInt16" };
+    static constexpr char16_t Int32[]{ u"System.Int32" };
+    static constexpr char16_t UInt32[]{ u"System.UInt32" };
+    static constexpr char16_t Int64[]{ u"System.Int64" };
+    static constexpr char16_t UInt64[]{ u"System.UInt64" };
+    static constexpr char16_t IntPtr[]{ u"System.IntPtr" };
+    static constexpr char16_t UIntPtr[]{ u"System.UIntPtr" };
+    static constexpr char16_t Char[]{ u"System.Char" };
+    static constexpr char16_t String[]{ u"System.String" };
+    static constexpr char16_t Object[]{ u"System.Object" };
+    static constexpr char16_t Type[]{ u"System.Type" };
 }
 
 template<typename T, typename Enable = void>
@@ -90,7 +92,9 @@ struct QDotNetInbound<QDotNetNull<T>>
 template<>\
 struct QDotNetTypeOf<T>\
 {\
-    static inline const QString TypeName = QString(QtDotNet::TypeNames::typeName);\
+    static inline const QString TypeName = QString::fromRawData(\
+        reinterpret_cast<const QChar *>(QtDotNet::TypeNames::typeName),\
+        static_cast<qsizetype>(std::size(QtDotNet::TypeNames::typeName) - 1));\
     static inline UnmanagedType MarshalAs = marshalAs;\
 }
 
@@ -146,12 +150,13 @@ template<typename T>
 struct QDotNetOutbound<T, std::enable_if_t<std::is_pointer_v<T>>>
 {
     using SourceType = T;
-    using OutboundType = void*;
+    using OutboundType = std::conditional_t<
+        std::is_const_v<std::remove_pointer_t<T>>, const void *, void *>;
     static inline const QDotNetParameter Parameter =
         QDotNetParameter(QDotNetTypeOf<void *>::TypeName, QDotNetTypeOf<void *>::MarshalAs);
     static OutboundType convert(SourceType srvValue)
     {
-        return reinterpret_cast<void *>(srvValue);
+        return reinterpret_cast<OutboundType>(srvValue);
     }
 };
 
@@ -175,6 +180,41 @@ struct QDotNetNull<T, std::enable_if_t<std::is_pointer_v<T>>>
     static bool isNull(const T &ptr) { return ptr == value(); }
 };
 
+// Enums are marshaled as their underlying type; the .NET type name and marshaling are given by
+// a specialization of QDotNetTypeOf (e.g. in headers generated by bindgen).
+template<typename T>
+struct QDotNetOutbound<T, std::enable_if_t<std::is_enum_v<T>>>
+{
+    using SourceType = T;
+    using OutboundType = std::underlying_type_t<T>;
+    static inline const QDotNetParameter Parameter =
+        QDotNetParameter(QDotNetTypeOf<T>::TypeName, QDotNetTypeOf<T>::MarshalAs);
+    static OutboundType convert(SourceType srvValue)
+    {
+        return static_cast<OutboundType>(srvValue);
+    }
+};
+
+template<typename T>
+struct QDotNetInbound<T, std::enable_if_t<std::is_enum_v<T>>>
+{
+    using InboundType = std::underlying_type_t<T>;
+    using TargetType = T;
+    static inline const QDotNetParameter Parameter =
+        QDotNetParameter(QDotNetTypeOf<T>::TypeName, QDotNetTypeOf<T>::MarshalAs);
+    static TargetType convert(InboundType inboundValue)
+    {
+        return static_cast<T>(inboundValue);
+    }
+};
+
+template<typename T>
+struct QDotNetNull<T, std::enable_if_t<std::is_enum_v<T>>>
+{
+    static T value() { return T{}; }
+    static bool isNull(const T &) { return false; }
+};
+
 template<>
 struct QDotNetOutbound<void>
 {
@@ -305,4 +345,7 @@ namespace QtDotNet
 
     template<typename T>
     T null() { return QDotNetNull<T>::value(); }
+
+    template<typename T>
+    const void *gcHandle(const T &obj) { return obj.gcHandle(); }
 }
@@ -17,6 +17,8 @@
 #   pragma GCC diagnostic pop
 #endif
 
+#include <array>
+
 class QDotNetObject : public QDotNetRef
 {
 private:
@@ -138,6 +140,7 @@ public:
     QDotNetObject &operator =(const QDotNetObject &cpySrc)
     {
         QDotNetRef::operator=(cpySrc);
+        objTypeName.clear();
         return *this;
     }
 
@@ -148,6 +151,7 @@ public:
     QDotNetObject &operator=(QDotNetObject &&movSrc) noexcept
     {
         QDotNetRef::operator=(std::move(movSrc));
+        objTypeName.clear();
         return *this;
     }
 
@@ -160,6 +164,14 @@ public:
         return objType;
     }
 
+    // Assembly-qualified name of the object's runtime type.
+    const QString &typeName() const
+    {
+        if (objTypeName.isEmpty() && isValid())
+            objTypeName = adapter().objectTypeName(*this);
+        return objTypeName;
+    }
+
     QString toString() const
     {
         return method("ToString", fnToString).invoke(*this);
@@ -173,12 +185,8 @@ public:
     template<typename TResult, typename ...TArg>
     QDotNetFunction<TResult, TArg...> method(const QString &methodName) const
     {
-        const QList<QDotNetParameter> parameters
-        {
-            QDotNetInbound<TResult>::Parameter,
-            QDotNetOutbound<TArg>::Parameter...
-        };
-        return adapter().resolveInstanceMethod(*this, methodName, parameters);
+        return adapter().resolveInstanceMethod(*this, methodName,
+            QtDotNet::signature<TResult, TArg...>());
     }
 
     template<typename TResult, typename ...TArg>
@@ -199,6 +207,17 @@ public:
         return func;
     }
 
+    // Resolve several instance methods with a single call into the adapter, e.g. the property
+    // getters of a wrapper class:
+    //     methods({ "get_Host", "get_Port" }, d->host, d->port);
+    // Functions that are already valid are left as they are.
+    template<typename ...TFunc>
+    void methods(const std::array<QString, sizeof...(TFunc)> &methodNames, TFunc &...funcs) const
+    {
+        QtDotNet::resolveMany(QDotNetAdapter::ResolveKind::Instance, {}, this, methodNames,
+            funcs...);
+    }
+
     template<typename TResult, typename ...TArg>
     QDotNetFunction<TResult, TArg...> staticMethod(const QString &methodName) const
     {
@@ -265,16 +284,27 @@ public:
         return adapter().object(*this, path);
     }
 
+    // Methods called by name are cached per call signature and thread, for the runtime type
+    // of the last object called (see QDotNetCallSite).
     template<typename TResult, typename ...TArg>
     TResult call(const QString &methodName, TArg... arg) const
     {
+        static thread_local QDotNetCallSite<TResult, TArg...> callSite;
+        const auto &func = callSite.instanceMethod(typeName(), methodName);
+        if (func.isValid())
+            return func.invoke(*this, arg...);
         return method<TResult, TArg...>(methodName).invoke(*this, arg...);
     }
 
     template<typename ...TArg>
     void call(const QString &methodName, TArg... arg) const
     {
-        method<void, TArg...>(methodName).invoke(*this, arg...);
+        static thread_local QDotNetCallSite<void, TArg...> callSite;
+        const auto &func = callSite.instanceMethod(typeName(), methodName);
+        if (func.isValid())
+            func.invoke(*this, arg...);
+        else
+            method<void, TArg...>(methodName).invoke(*this, arg...);
     }
 
 protected:
@@ -311,6 +341,7 @@ private:
     mutable QDotNetType objType = nullptr;
     mutable QDotNetFunction<QString> fnToString;
     mutable QDotNetFunction<bool, QDotNetRef> fnEquals;
+    mutable QString objTypeName;
 };
 
 template<typename T>
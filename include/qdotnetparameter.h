@@ -31,6 +31,8 @@ constexpr auto FLAGS_OUT_BIT = 1;
 constexpr auto FLAGS_ARRAY_BIT = 2;
 constexpr auto FLAGS_FIXEDLENGTH_BIT = 3;
 constexpr auto FLAGS_WEAKREF_BIT = 4;
+constexpr auto FLAGS_PREPARE_BIT = 5;
+constexpr auto FLAGS_PREPARE_SIZE = 2;
 
 constexpr auto ARRAYLENGTH_OFFSET = FLAGS_OFFSET + FLAGS_SIZE;
 constexpr auto ARRAYLENGTH_SIZE = 32;
@@ -7,12 +7,26 @@
 
 #include "qdotnetadapter.h"
 
+#ifdef __GNUC__
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wconversion"
+#endif
+#include <QAtomicInteger>
+#ifdef __GNUC__
+#   pragma GCC diagnostic pop
+#endif
+
+#include <utility>
+
+// Reference to a .NET object. Copies of a reference share the same GC handle, through a native
+// ref-counted block; the handle is released when the last copy is destroyed. Copying and
+// destroying a reference therefore do not call into .NET, except to release the handle.
 class QDotNetRef
 {
 public:
     static inline const QString &FullyQualifiedTypeName = QStringLiteral("System.Object");
 
-    const void *gcHandle() const { return objectRef; }
+    const void *gcHandle() const { return handle ? handle->objectRef : nullptr; }
     bool isValid() const { return gcHandle() != nullptr; }
 
     template<typename T, std::enable_if_t<std::is_base_of_v<QDotNetRef, T>, bool> = true>
@@ -27,7 +41,7 @@ public:
     }
 
     QDotNetRef(const void *objectRef = nullptr)
-        : objectRef(objectRef)
+        : handle(objectRef ? new SharedHandle(objectRef) : nullptr)
     {}
 
     QDotNetRef(const QDotNetRef &cpySrc)
@@ -64,35 +78,54 @@ protected:
 
     void attach(const void *objectRef)
     {
-        this->objectRef = objectRef;
+        freeObjectRef();
+        if (objectRef)
+            handle = new SharedHandle(objectRef);
     }
 
     QDotNetRef &copyFrom(const QDotNetRef &that)
     {
+        if (handle == that.handle)
+            return *this;
+        if (that.handle)
+            that.handle->refCount.ref();
         freeObjectRef();
-        if (that.isValid())
-            objectRef = adapter().addObjectRef(that);
+        handle = that.handle;
         return *this;
     }
 
     QDotNetRef &moveFrom(QDotNetRef &that)
     {
+        if (this == &that)
+            return *this;
         freeObjectRef();
-        objectRef = that.objectRef;
-        that.objectRef = nullptr;
+        handle = std::exchange(that.handle, nullptr);
         return *this;
     }
 
 private:
+    // GC handle shared by all copies of a reference
+    struct SharedHandle
+    {
+        explicit SharedHandle(const void *objectRef)
+            : objectRef(objectRef)
+        {}
+        const void *const objectRef;
+        QAtomicInt refCount{ 1 };
+    };
+
     void freeObjectRef()
     {
-        if (!isValid())
+        if (!handle)
             return;
-        adapter().freeObjectRef(*this);
-        objectRef = nullptr;
+        if (!handle->refCount.deref()) {
+            adapter().freeObjectRef(*this);
+            delete handle;
+        }
+        handle = nullptr;
     }
 
-    const void *objectRef = nullptr;
+    SharedHandle *handle = nullptr;
 };
 
 template<typename T>
@@ -27,13 +27,8 @@ public:
     QDotNetSafeMethod(FuncType func)
         : func(func)
     {
-        const QList<QDotNetParameter> parameters
-        {
-            QDotNetInbound<QDotNetRef>::Parameter,
-            QDotNetOutbound<QDotNetRef>::Parameter,
-            QDotNetOutbound<TArg>::Parameter...
-        };
-        safeFunc = QDotNetAdapter::instance().resolveSafeMethod(func.ptr(), parameters);
+        safeFunc = QDotNetAdapter::instance().resolveSafeMethod(func.ptr(),
+            QtDotNet::signature<QDotNetRef, QDotNetRef, TArg...>());
     }
 
     bool isValid() const { return func.isValid(); }
@@ -57,7 +52,7 @@ public:
         {
             if (!fnValue.isValid()) {
                 fnValue = adapter().resolveInstanceMethod(
-                    *this, "get_Value", { QDotNetInbound<T>::Parameter });
+                    *this, "get_Value", QtDotNet::signature<T>());
             }
             return fnValue();
         }
@@ -65,7 +60,7 @@ public:
         {
             if (!fnException.isValid()) {
                 fnException = adapter().resolveInstanceMethod(
-                    *this, "get_Exception", { QDotNetInbound<QDotNetException>::Parameter });
+                    *this, "get_Exception", QtDotNet::signature<QDotNetException>());
             }
             return fnException();
         }
@@ -110,13 +105,8 @@ public:
     QDotNetSafeMethod(FuncType func)
         : func(func)
     {
-        const QList<QDotNetParameter> parameters
-        {
-            QDotNetInbound<QDotNetRef>::Parameter,
-            QDotNetOutbound<QDotNetRef>::Parameter,
-            QDotNetOutbound<TArg>::Parameter...
-        };
-        safeFunc = QDotNetAdapter::instance().resolveSafeMethod(func.ptr(), parameters);
+        safeFunc = QDotNetAdapter::instance().resolveSafeMethod(func.ptr(),
+            QtDotNet::signature<QDotNetRef, QDotNetRef, TArg...>());
     }
 
     bool isValid() const { return func.isValid(); }
@@ -140,7 +130,7 @@ public:
         {
             if (!fnException.isValid()) {
                 fnException = QDotNetAdapter::instance().resolveInstanceMethod(
-                    *this, "get_Exception", { QDotNetInbound<QDotNetException>::Parameter });
+                    *this, "get_Exception", QtDotNet::signature<QDotNetException>());
             }
             return fnException();
         }
@@ -0,0 +1,102 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+#pragma once
+
+#include "qdotnetmarshal.h"
+
+#ifdef __GNUC__
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wconversion"
+#endif
+#include <QList>
+#ifdef __GNUC__
+#   pragma GCC diagnostic pop
+#endif
+
+#include <array>
+
+// Signature of a method, i.e. the parameter info of the return type followed by the parameter
+// info of each argument. A signature refers to an array of parameters owned by the caller (see
+// QtDotNet::signature() for signatures built once per combination of types).
+// The hash of a signature (64-bit FNV-1a of the type names and parameter info) depends only on
+// its contents, and not on the process or hash seed.
+class QDotNetSignature
+{
+public:
+    QDotNetSignature(const QDotNetParameter *params, qsizetype count, quint64 hash)
+        : params(params), count(count), sigHash(hash)
+    {}
+
+    QDotNetSignature(const QDotNetParameter *params, qsizetype count)
+        : QDotNetSignature(params, count, computeHash(params, count))
+    {}
+
+    explicit QDotNetSignature(const QList<QDotNetParameter> &params)
+        : QDotNetSignature(params.constData(), params.size())
+    {}
+
+    template<std::size_t N>
+    explicit QDotNetSignature(const std::array<QDotNetParameter, N> &params)
+        : QDotNetSignature(params.data(), static_cast<qsizetype>(N))
+    {}
+
+    const QDotNetParameter *data() const { return params; }
+    qsizetype size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    quint64 hash() const { return sigHash; }
+    const QDotNetParameter &operator[](qsizetype i) const { return params[i]; }
+    const QDotNetParameter *begin() const { return params; }
+    const QDotNetParameter *end() const { return params + count; }
+
+    QList<QDotNetParameter> toList() const { return QList<QDotNetParameter>(begin(), end()); }
+
+    static quint64 computeHash(const QDotNetParameter *params, qsizetype count)
+    {
+        quint64 hash = FnvOffsetBasis;
+        for (qsizetype i = 0; i < count; ++i) {
+            const auto *typeName = reinterpret_cast<const char16_t *>(params[i].typeName);
+            for (; typeName != nullptr && *typeName != u'\0'; ++typeName)
+                hash = fnv1a(hash, *typeName, sizeof(char16_t));
+            hash = fnv1a(hash, 0, sizeof(char16_t));
+            hash = fnv1a(hash, params[i].paramInfo, sizeof(quint64));
+        }
+        return hash;
+    }
+
+private:
+    static constexpr quint64 FnvOffsetBasis = 14695981039346656037ull;
+    static constexpr quint64 FnvPrime = 1099511628211ull;
+
+    static constexpr quint64 fnv1a(quint64 hash, quint64 value, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i, value >>= 8)
+            hash = (hash ^ (value & 0xFF)) * FnvPrime;
+        return hash;
+    }
+
+    const QDotNetParameter *params = nullptr;
+    qsizetype count = 0;
+    quint64 sigHash = 0;
+};
+
+namespace QtDotNet
+{
+    // Signature of a method with the given return and argument types. The parameter array and
+    // hash are built on first use and shared by all callers; no allocation takes place after
+    // that.
+    template<typename TResult, typename... TArg>
+    QDotNetSignature signature()
+    {
+        static const std::array<QDotNetParameter, sizeof...(TArg) + 1> params
+        {
+            QDotNetInbound<TResult>::Parameter,
+            QDotNetOutbound<TArg>::Parameter...
+        };
+        static const quint64 hash = QDotNetSignature::computeHash(
+            params.data(), static_cast<qsizetype>(params.size()));
+        return QDotNetSignature(params.data(), static_cast<qsizetype>(params.size()), hash);
+    }
+}
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "qdotnetcallsite.h"
 #include "qdotnetsafemethod.h"
 
 #ifdef __GNUC__
@@ -16,6 +17,58 @@
 #   pragma GCC diagnostic pop
 #endif
 
+#include <array>
+
+namespace QtDotNet
+{
+    // Signature of the method called through a function, and assignment of a resolved function
+    // pointer; used to resolve several functions in one batch (see QDotNetAdapter::resolveMany()).
+    template<typename TResult, typename ...TArg>
+    QDotNetSignature signatureOf(const QDotNetFunction<TResult, TArg...> &)
+    {
+        return signature<TResult, TArg...>();
+    }
+
+    template<typename TResult, typename ...TArg>
+    QDotNetSignature signatureOf(const QDotNetSafeMethod<TResult, TArg...> &)
+    {
+        return signature<TResult, TArg...>();
+    }
+
+    template<typename TResult, typename ...TArg>
+    void setFunction(QDotNetFunction<TResult, TArg...> &func, void *funcPtr)
+    {
+        if (!func.isValid() && funcPtr != nullptr)
+            func = QDotNetFunction<TResult, TArg...>(funcPtr);
+    }
+
+    template<typename TResult, typename ...TArg>
+    void setFunction(QDotNetSafeMethod<TResult, TArg...> &func, void *funcPtr)
+    {
+        if (!func.isValid() && funcPtr != nullptr)
+            func = QDotNetFunction<TResult, TArg...>(funcPtr);
+    }
+
+    template<typename ...TFunc>
+    void resolveMany(const QDotNetAdapter::ResolveKind kind, const QString &typeName,
+        const QDotNetRef *objectRef, const std::array<QString, sizeof...(TFunc)> &methodNames,
+        TFunc &...funcs)
+    {
+        if ((funcs.isValid() && ...))
+            return;
+        QList<QDotNetAdapter::ResolveRequest> requests;
+        requests.reserve(sizeof...(TFunc));
+        std::size_t i = 0;
+        (requests.append({ kind, methodNames[i++], signatureOf(funcs) }), ...);
+        const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+        const QList<void *> funcPtrs = objectRef != nullptr
+            ? adapter.resolveMany(*objectRef, requests)
+            : adapter.resolveMany(typeName, requests);
+        i = 0;
+        (setFunction(funcs, funcPtrs.value(static_cast<qsizetype>(i++))), ...);
+    }
+}
+
 class QDotNetType : public QDotNetRef
 {
 public:
@@ -26,7 +79,7 @@ public:
     {}
 
     QDotNetType(const QDotNetType &cpySrc)
-        : QDotNetRef(adapter().addObjectRef(&cpySrc))
+        : QDotNetRef(cpySrc)
     {}
 
     QDotNetType &operator =(const QDotNetType &cpySrc)
@@ -73,12 +126,8 @@ public:
     static QDotNetFunction<TResult, TArg...> staticMethod(const QString &typeName,
         const QString &methodName)
     {
-        const QList<QDotNetParameter> parameters
-        {
-            QDotNetInbound<TResult>::Parameter,
-            QDotNetOutbound<TArg>::Parameter...
-        };
-        return adapter().resolveStaticMethod(typeName, methodName, parameters);
+        return adapter().resolveStaticMethod(typeName, methodName,
+            QtDotNet::signature<TResult, TArg...>());
     }
 
     template<typename TResult, typename ...TArg>
@@ -123,15 +172,67 @@ public:
         return func;
     }
 
+    // Resolve several static methods of a type with a single call into the adapter, e.g.
+    //     staticMethods(typeName, { "Min", "Max" }, fnMin, fnMax);
+    // Functions that are already valid are left as they are.
+    template<typename ...TFunc>
+    static void staticMethods(const QString &typeName,
+        const std::array<QString, sizeof...(TFunc)> &methodNames, TFunc &...funcs)
+    {
+        QtDotNet::resolveMany(QDotNetAdapter::ResolveKind::Static, typeName, nullptr,
+            methodNames, funcs...);
+    }
+
+    // Open-instance method, i.e. a function that can be invoked on any object of the type and that
+    // takes the target object as the first argument of invoke().
+    template<typename TResult, typename ...TArg>
+    static QDotNetFunction<TResult, TArg...> instanceMethod(const QString &typeName,
+        const QString &methodName)
+    {
+        const std::array<QDotNetParameter, sizeof...(TArg) + 2> parameters
+        {
+            QDotNetInbound<TResult>::Parameter,
+            QDotNetParameter(typeName, UnmanagedType::ObjectRef),
+            QDotNetOutbound<TArg>::Parameter...
+        };
+        return QDotNetFunction<TResult, TArg...>(adapter().resolveOpenInstanceMethod(
+            typeName, methodName, QDotNetSignature(parameters)),
+            QDotNetFunctionKind::OpenInstance);
+    }
+
+    template<typename TResult, typename ...TArg>
+    static QDotNetFunction<TResult, TArg...> &instanceMethod(const QString &typeName,
+        const QString &methodName, QDotNetFunction<TResult, TArg...> &func)
+    {
+        if (!func.isValid())
+            func = instanceMethod<TResult, TArg...>(typeName, methodName);
+        return func;
+    }
+
+    template<typename TResult, typename ...TArg>
+    QDotNetFunction<TResult, TArg...> instanceMethod(const QString &methodName) const
+    {
+        return instanceMethod<TResult, TArg...>(fullName(), methodName);
+    }
+
+    template<typename TResult, typename ...TArg>
+    QDotNetFunction<TResult, TArg...> &instanceMethod(const QString &methodName,
+        QDotNetFunction<TResult, TArg...> &func) const
+    {
+        if (!func.isValid())
+            func = instanceMethod<TResult, TArg...>(methodName);
+        return func;
+    }
+
     template<typename T, typename ...TArg>
     static QDotNetFunction<T, TArg...> constructor(const QString &typeName)
     {
-        const QList<QDotNetParameter> parameters
+        const std::array<QDotNetParameter, sizeof...(TArg) + 1> parameters
         {
             QDotNetParameter(typeName, UnmanagedType::ObjectRef),
             QDotNetOutbound<TArg>::Parameter...
         };
-        return adapter().resolveConstructor(parameters);
+        return adapter().resolveConstructor(QDotNetSignature(parameters));
     }
 
     template<typename T, typename ...TArg>
@@ -196,6 +297,7 @@ namespace QtDotNet
     template<typename T, typename... TArg>
     T call(const QString &type, const QString &method, TArg... arg)
     {
-        return QDotNetType::staticMethod<T, TArg...>(type, method).invoke(nullptr, arg...);
+        static thread_local QDotNetCallSite<T, TArg...> callSite;
+        return callSite.staticMethod(type, method).invoke(nullptr, arg...);
     }
 }
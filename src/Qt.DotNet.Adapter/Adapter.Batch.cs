@@ -0,0 +1,135 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        /// <summary>
+        /// Kind of method in a batch resolve request (see ResolveMany()).
+        /// </summary>
+        public enum ResolveKind
+        {
+            Static,
+            Constructor,
+            Instance,
+            OpenInstance
+        }
+
+        /// <summary>
+        /// Request to resolve a method, as part of a batch (see ResolveMany()).
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Unicode)]
+        public struct ResolveRequest
+        {
+            [MarshalAs(UnmanagedType.LPWStr)]
+            public string MethodName;
+            public int Kind;
+            public int SignatureId;
+            public int PrepareMode;
+        }
+
+        /// <summary>
+        /// Resolve several methods of one type or object, with registered signatures (see
+        /// RegisterSignature()). The public methods of the target type are looked up once for
+        /// the whole batch. Static and open-instance methods are looked up in the type given by
+        /// typeName or, if null, in the runtime type of the target object. Instance methods are
+        /// bound to the target object. The method name of constructors is ignored.
+        /// </summary>
+        /// <param name="typeName">Target type, or null for the type of the target object</param>
+        /// <param name="objRefPtr">Target object reference, or zero</param>
+        /// <param name="requestCount">Number of elements in requests and funcPtrs</param>
+        /// <param name="requests">Methods to resolve</param>
+        /// <param name="funcPtrs">Function pointer of each method; zero if not resolved</param>
+        /// <returns>Number of methods resolved</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static int ResolveMany(
+            string typeName,
+            IntPtr objRefPtr,
+            int requestCount,
+            ResolveRequest[] requests,
+            IntPtr[] funcPtrs)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveMany(ResolveMany);
+#endif
+            if (requests == null || funcPtrs == null || funcPtrs.Length < requests.Length)
+                throw new ArgumentException("Invalid request list", nameof(requests));
+
+            object obj = null;
+            if (objRefPtr != IntPtr.Zero) {
+                obj = GetObjectRefFromPtr(objRefPtr)?.Target
+                    ?? throw new ArgumentException("Invalid object reference", nameof(objRefPtr));
+            }
+            var type = string.IsNullOrEmpty(typeName) ? obj?.GetType() : TypeCache.GetType(typeName);
+
+            // Public methods of the target type, by name
+            var methodsByName = type?
+                .GetMethods(BindingFlags.Public | BindingFlags.Static | BindingFlags.Instance)
+                .ToLookup(x => x.Name);
+
+            int resolved = 0;
+            for (int i = 0; i < requests.Length; ++i) {
+                try {
+                    funcPtrs[i] = ResolveRequested(type, obj, methodsByName, requests[i]);
+                } catch (Exception) {
+                    funcPtrs[i] = IntPtr.Zero;
+                }
+                if (funcPtrs[i] != IntPtr.Zero)
+                    ++resolved;
+            }
+            return resolved;
+        }
+
+        private static IntPtr ResolveRequested(
+            Type type,
+            object obj,
+            ILookup<string, MethodInfo> methodsByName,
+            ResolveRequest request)
+        {
+            var signature = Signature.Get(request.SignatureId);
+            var prepareMode = GetPrepareMode(request.PrepareMode);
+            var kind = (ResolveKind)request.Kind;
+            if (kind == ResolveKind.Constructor)
+                return ResolveConstructor(signature, prepareMode);
+
+            if (type == null || methodsByName == null)
+                throw new ArgumentException("Target type not found", "typeName");
+            if (kind == ResolveKind.Instance && obj == null)
+                throw new ArgumentException("Invalid object reference", "objRefPtr");
+
+            var isStatic = kind == ResolveKind.Static;
+            var skip = kind == ResolveKind.OpenInstance ? 2 : 1;
+            var candidates = methodsByName[request.MethodName ?? string.Empty]
+                .Where(x => x.IsStatic == isStatic)
+                .ToArray<MethodBase>();
+            if (candidates.Length == 0) {
+                throw new ArgumentException(
+                    $"Method '{request.MethodName}' not found", "methodName");
+            }
+
+            // Same overload resolution as Type.GetMethod()
+            var bindingFlags = BindingFlags.Public
+                | (isStatic ? BindingFlags.Static : BindingFlags.Instance);
+            var method = Type.DefaultBinder.SelectMethod(
+                bindingFlags, candidates, signature.GetParameterTypes(skip), null) as MethodInfo
+                ?? throw new ArgumentException(
+                    $"Method '{request.MethodName}' not found", "methodName");
+
+            return kind switch
+            {
+                ResolveKind.Static => ResolveStaticMethod(type, method, signature, prepareMode),
+                ResolveKind.Instance => ResolveInstanceMethod(obj, method, signature, prepareMode),
+                ResolveKind.OpenInstance
+                    => ResolveOpenInstanceMethod(type, method, signature, prepareMode),
+                _ => throw new ArgumentException("Invalid request kind", "kind")
+            };
+        }
+    }
+}
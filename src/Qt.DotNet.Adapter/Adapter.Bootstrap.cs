@@ -0,0 +1,133 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        /// <summary>
+        /// Version of the layout of the function table filled in by Bootstrap(). New functions
+        /// are appended to the end of the table without changing the version.
+        /// </summary>
+        /// <remarks>
+        /// Version 2: table entries point to [UnmanagedCallersOnly] functions (see Unmanaged).
+        /// </remarks>
+        public const int FunctionTableVersion = 2;
+
+        // Function table header: version (int), function count (int)
+        private const int FunctionTableHeaderSize = 2 * sizeof(int);
+
+        /// <summary>
+        /// Adapter public functions, in function table order.
+        /// </summary>
+        private static IntPtr[] FunctionTable { get; } = GetFunctionTable();
+
+        private static unsafe IntPtr[] GetFunctionTable()
+        {
+            return new[]
+            {
+                (IntPtr)(delegate* unmanaged<char*, int, byte>)
+                    &Unmanaged.LoadAssembly,
+                (IntPtr)(delegate* unmanaged<char*, int, char*, int, int, NativeParameter*, IntPtr>)
+                    &Unmanaged.ResolveStaticMethod,
+                (IntPtr)(delegate* unmanaged<int, NativeParameter*, IntPtr>)
+                    &Unmanaged.ResolveConstructor,
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, int, NativeParameter*, IntPtr>)
+                    &Unmanaged.ResolveInstanceMethod,
+                (IntPtr)(delegate* unmanaged<IntPtr, int, NativeParameter*, IntPtr>)
+                    &Unmanaged.ResolveSafeMethod,
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, IntPtr, IntPtr, void>)
+                    &Unmanaged.AddEventHandler,
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, IntPtr, void>)
+                    &Unmanaged.RemoveEventHandler,
+                (IntPtr)(delegate* unmanaged<IntPtr, void>)
+                    &Unmanaged.RemoveAllEventHandlers,
+                (IntPtr)(delegate* unmanaged<IntPtr, byte, IntPtr>)
+                    &Unmanaged.AddObjectRef,
+                (IntPtr)(delegate* unmanaged<IntPtr, void>)
+                    &Unmanaged.FreeDelegateRef,
+                (IntPtr)(delegate* unmanaged<IntPtr, void>)
+                    &Unmanaged.FreeObjectRef,
+                (IntPtr)(delegate* unmanaged<char*, int, void>)
+                    &Unmanaged.FreeTypeRef,
+                (IntPtr)(delegate* unmanaged<char*, int, IntPtr>)
+                    &Unmanaged.AddInterfaceProxy,
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, int, NativeParameter*,
+                        IntPtr, IntPtr, IntPtr, void>)
+                    &Unmanaged.SetInterfaceMethod,
+#if DEBUG || TESTS
+                (IntPtr)(delegate* unmanaged<int*, int*, int*, void>)
+                    &Unmanaged.Stats,
+#else
+                IntPtr.Zero,
+#endif
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, IntPtr>)
+                    &Unmanaged.GetObject,
+                (IntPtr)(delegate* unmanaged<GCInfo*, void>)
+                    &Unmanaged.GetGCInfo,
+                (IntPtr)(delegate* unmanaged<void>)
+                    &Unmanaged.StartProfile,
+                (IntPtr)(delegate* unmanaged<char*, int, byte>)
+                    &Unmanaged.SaveProfile,
+                (IntPtr)(delegate* unmanaged<char*, int, int>)
+                    &Unmanaged.ReplayProfile,
+                (IntPtr)(delegate* unmanaged<int, void>)
+                    &Unmanaged.SetPrepareMode,
+                (IntPtr)(delegate* unmanaged<long*, int, int>)
+                    &Unmanaged.GetCounters,
+                (IntPtr)(delegate* unmanaged<char*, int, char*, int, int, NativeParameter*, IntPtr>)
+                    &Unmanaged.ResolveOpenInstanceMethod,
+                (IntPtr)(delegate* unmanaged<IntPtr, void>)
+                    &Unmanaged.SetRefFreedCallback,
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, int>)
+                    &Unmanaged.GetObjectTypeName,
+                (IntPtr)(delegate* unmanaged<int, NativeParameter*, int>)
+                    &Unmanaged.RegisterSignature,
+                (IntPtr)(delegate* unmanaged<char*, int, char*, int, int, int, IntPtr>)
+                    &Unmanaged.ResolveStaticMethodById,
+                (IntPtr)(delegate* unmanaged<int, int, IntPtr>)
+                    &Unmanaged.ResolveConstructorById,
+                (IntPtr)(delegate* unmanaged<IntPtr, char*, int, int, int, IntPtr>)
+                    &Unmanaged.ResolveInstanceMethodById,
+                (IntPtr)(delegate* unmanaged<char*, int, char*, int, int, int, IntPtr>)
+                    &Unmanaged.ResolveOpenInstanceMethodById,
+                (IntPtr)(delegate* unmanaged<IntPtr, int, int, IntPtr>)
+                    &Unmanaged.ResolveSafeMethodById,
+                (IntPtr)(delegate* unmanaged<char*, int, IntPtr, int, NativeResolveRequest*,
+                        IntPtr*, int>)
+                    &Unmanaged.ResolveMany,
+            };
+        }
+
+        /// <summary>
+        /// Fill in a native table with pointers to all Adapter public functions. The table
+        /// starts with a header (version and function count, both 32-bit integers), followed
+        /// by the function pointers. Functions that do not fit in the table are left out.
+        /// Unavailable functions (e.g. Stats in release builds) are set to null.
+        /// Bootstrap() itself uses the default component entry point signature, so that it can
+        /// be resolved without a delegate type.
+        /// </summary>
+        /// <param name="table">Pointer to the native function table</param>
+        /// <param name="tableSize">Size of the native function table, in bytes</param>
+        /// <returns>0 if successful; -1 otherwise</returns>
+        public static int Bootstrap(IntPtr table, int tableSize)
+        {
+            if (table == IntPtr.Zero || tableSize < FunctionTableHeaderSize)
+                return -1;
+
+            var count = Math.Min(FunctionTable.Length,
+                (tableSize - FunctionTableHeaderSize) / IntPtr.Size);
+            Marshal.WriteInt32(table, 0, FunctionTableVersion);
+            Marshal.WriteInt32(table, sizeof(int), count);
+            for (int i = 0; i < count; ++i) {
+                var offset = FunctionTableHeaderSize + i * IntPtr.Size;
+                Marshal.WriteIntPtr(table, offset, FunctionTable[i]);
+            }
+            return 0;
+        }
+    }
+}
@@ -44,6 +44,16 @@ namespace Qt.DotNet
                 [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2)]
                 [In] Parameter[] parameters);
 
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate IntPtr ResolveOpenInstanceMethod(
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string typeName,
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string methodName,
+                [In] int parameterCount,
+                [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2)]
+                [In] Parameter[] parameters);
+
             [UnmanagedFunctionPointer(CallingConvention.Winapi)]
             public delegate IntPtr ResolveSafeMethod(
                 [In] IntPtr funcPtr,
@@ -125,6 +135,90 @@ namespace Qt.DotNet
             public delegate IntPtr GetObject
                 ([In] IntPtr objRefPtr, [MarshalAs(UnmanagedType.LPWStr)][In] string path);
 
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate void GetGCInfo(
+                [Out] out GCInfo info);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate void StartProfile();
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate bool SaveProfile(
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string path);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate int ReplayProfile(
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string path);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate void SetPrepareMode([In] int mode);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate int GetCounters([In] IntPtr counters, [In] int count);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate void SetRefFreedCallback([In] IntPtr callback);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            [return: MarshalAs(UnmanagedType.LPWStr)]
+            public delegate string GetObjectTypeName([In] IntPtr objRefPtr);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate int RegisterSignature(
+                [In] int parameterCount,
+                [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 0)]
+                [In] Parameter[] parameters);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate IntPtr ResolveStaticMethodById(
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string typeName,
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string methodName,
+                [In] int signatureId,
+                [In] int prepareMode);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate IntPtr ResolveConstructorById(
+                [In] int signatureId,
+                [In] int prepareMode);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate IntPtr ResolveInstanceMethodById(
+                [In] IntPtr objRefPtr,
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string methodName,
+                [In] int signatureId,
+                [In] int prepareMode);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate IntPtr ResolveOpenInstanceMethodById(
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string typeName,
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string methodName,
+                [In] int signatureId,
+                [In] int prepareMode);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate IntPtr ResolveSafeMethodById(
+                [In] IntPtr funcPtr,
+                [In] int signatureId,
+                [In] int prepareMode);
+
+            [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+            public delegate int ResolveMany(
+                [MarshalAs(UnmanagedType.LPWStr)]
+                [In] string typeName,
+                [In] IntPtr objRefPtr,
+                [In] int requestCount,
+                [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2)]
+                [In] ResolveRequest[] requests,
+                [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2)]
+                [Out] IntPtr[] funcPtrs);
+
 #if DEBUG || TESTS
             [UnmanagedFunctionPointer(CallingConvention.Winapi)]
             public delegate void Stats(
@@ -0,0 +1,61 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Runtime;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        /// <summary>
+        /// Garbage collector mode and statistics (see QDotNetAdapter::GCInfo).
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct GCInfo
+        {
+            public int IsServerGC;
+            public int LatencyMode;
+            public long HeapSizeBytes;
+            public long TotalCommittedBytes;
+            public long TotalAvailableMemoryBytes;
+            public long LastPauseDurationTicks;
+            public long Gen0Collections;
+            public long Gen1Collections;
+            public long Gen2Collections;
+            public double PauseTimePercentage;
+        }
+
+        /// <summary>
+        /// Get the current garbage collector mode and statistics
+        /// </summary>
+        /// <param name="info">GC mode and statistics</param>
+        public static void GetGCInfo(out GCInfo info)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.GetGCInfo(GetGCInfo);
+#endif
+            var memoryInfo = GC.GetGCMemoryInfo();
+            var lastPauseDuration = TimeSpan.Zero;
+            foreach (var pauseDuration in memoryInfo.PauseDurations)
+                lastPauseDuration += pauseDuration;
+
+            info = new GCInfo
+            {
+                IsServerGC = GCSettings.IsServerGC ? 1 : 0,
+                LatencyMode = (int)GCSettings.LatencyMode,
+                HeapSizeBytes = memoryInfo.HeapSizeBytes,
+                TotalCommittedBytes = memoryInfo.TotalCommittedBytes,
+                TotalAvailableMemoryBytes = memoryInfo.TotalAvailableMemoryBytes,
+                LastPauseDurationTicks = lastPauseDuration.Ticks,
+                Gen0Collections = GC.CollectionCount(0),
+                Gen1Collections = GC.CollectionCount(1),
+                Gen2Collections = GC.CollectionCount(2),
+                PauseTimePercentage = memoryInfo.PauseTimePercentage
+            };
+        }
+    }
+}
@@ -22,36 +22,68 @@ namespace Qt.DotNet
             // Compile-time signature check of delegate vs. method
             _ = new Delegates.ResolveStaticMethod(ResolveStaticMethod);
 #endif
-            var type = Type.GetType(typeName)
+            var prepareMode = TakePrepareMode(parameters);
+            return ResolveStaticMethod(
+                typeName, methodName, Signature.Get(parameters), prepareMode);
+        }
+
+        /// <summary>
+        /// Resolve a static method with a registered signature (see RegisterSignature()).
+        /// </summary>
+        /// <param name="typeName">Type that declares the method</param>
+        /// <param name="methodName">Name of the method</param>
+        /// <param name="signatureId">ID of the signature of the method</param>
+        /// <param name="prepareMode">PrepareMode value</param>
+        /// <returns>Function pointer</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static IntPtr ResolveStaticMethodById(
+            string typeName,
+            string methodName,
+            int signatureId,
+            int prepareMode)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveStaticMethodById(ResolveStaticMethodById);
+#endif
+            return ResolveStaticMethod(
+                typeName, methodName, Signature.Get(signatureId), GetPrepareMode(prepareMode));
+        }
+
+        private static IntPtr ResolveStaticMethod(
+            string typeName,
+            string methodName,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            var type = TypeCache.GetType(typeName)
                 ?? throw new ArgumentException($"Type '{typeName}' not found", nameof(typeName));
 
-            var sigTypes = parameters
-                .Skip(1)
-                .Select((x, i) => x.GetParameterType()
-                    ?? throw new ArgumentException($"Type not found [{i}]", nameof(parameters)))
-                .ToArray();
+            var sigTypes = signature.GetParameterTypes(1);
 
             var method = type.GetMethod(
                 methodName, BindingFlags.Public | BindingFlags.Static, sigTypes)
                 ?? throw new ArgumentException(
                     $"Method '{methodName}' not found", nameof(methodName));
 
+            return ResolveStaticMethod(type, method, signature, prepareMode);
+        }
+
+        private static IntPtr ResolveStaticMethod(
+            Type type,
+            MethodInfo method,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            RecordResolve(ProfileEntryKind.Static, type, method, signature.Parameters);
             if (DelegatesByMethod.TryGetValue((type, method), out var objMethod))
                 return objMethod.FuncPtr;
 
-            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(method, parameters)
-                ?? throw new ArgumentException("Error getting method delegate", nameof(methodName));
-
-            var methodDelegate = Delegate.CreateDelegate(delegateType, method, false)
-                ?? throw new ArgumentException("Error getting method delegate", nameof(methodName));
-
-            var methodHandle = GCHandle.Alloc(methodDelegate);
-            var methodFuncPtr = Marshal.GetFunctionPointerForDelegate(methodDelegate);
-
-            var delegateRef = new DelegateRef(methodHandle, methodFuncPtr);
-            DelegateRefs.TryAdd(methodFuncPtr, (type, method, delegateRef));
-            DelegatesByMethod.TryAdd((type, method), delegateRef);
-            return methodFuncPtr;
+            var delegateRef = CreateStaticDelegateRef(
+                method, signature, "Error getting method delegate", "methodName");
+            AddDelegateRef(type, method, delegateRef);
+            PrepareMethods(prepareMode, method);
+            return delegateRef.FuncPtr;
         }
 
         public static IntPtr ResolveConstructor(
@@ -64,38 +96,69 @@ namespace Qt.DotNet
 #endif
             if (parameters == null || parameters.Length == 0)
                 throw new ArgumentException("Null or empty param list", nameof(parameters));
+            var prepareMode = TakePrepareMode(parameters);
+            return ResolveConstructor(Signature.Get(parameters), prepareMode);
+        }
 
-            if (parameters[0].IsVoid)
-                throw new ArgumentException("Constructor cannot return void", nameof(parameters));
-
-            var type = parameters[0].GetParameterType()
-                ?? throw new ArgumentException("Return type not found", nameof(parameters));
-
-            var paramTypes = parameters
-                .Skip(1)
-                .Select((x, i) => x.GetParameterType()
-                    ?? throw new ArgumentException($"Type not found [{i}]", nameof(parameters)))
-                .ToArray();
+        /// <summary>
+        /// Resolve a constructor with a registered signature (see RegisterSignature()).
+        /// </summary>
+        /// <param name="signatureId">ID of the signature of the constructor, starting with the
+        /// type of the object to create</param>
+        /// <param name="prepareMode">PrepareMode value</param>
+        /// <returns>Function pointer</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static IntPtr ResolveConstructorById(int signatureId, int prepareMode)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveConstructorById(ResolveConstructorById);
+#endif
+            return ResolveConstructor(Signature.Get(signatureId), GetPrepareMode(prepareMode));
+        }
 
-            var ctor = type.GetConstructor(paramTypes)
-                ?? throw new ArgumentException("Constructor not found", nameof(parameters));
+        private static IntPtr ResolveConstructor(Signature signature, PrepareMode prepareMode)
+        {
+            if (signature.Length == 0)
+                throw new ArgumentException("Null or empty param list", "parameters");
+            if (signature.Parameters[0].IsVoid)
+                throw new ArgumentException("Constructor cannot return void", "parameters");
 
-            var ctorProxy = CodeGenerator.CreateProxyMethodForCtor(ctor, parameters)
-                ?? throw new ArgumentException("Error getting ctor delegate", nameof(parameters));
+            var type = signature.GetParameterType(0)
+                ?? throw new ArgumentException("Return type not found", "parameters");
 
-            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(ctorProxy, parameters)
-                ?? throw new ArgumentException("Error getting ctor delegate", nameof(parameters));
+            var paramTypes = signature.GetParameterTypes(1);
 
-            var methodDelegate = Delegate.CreateDelegate(delegateType, ctorProxy, false)
-                ?? throw new ArgumentException("Error getting ctor delegate", nameof(parameters));
+            var ctor = type.GetConstructor(paramTypes)
+                ?? throw new ArgumentException("Constructor not found", "parameters");
 
-            var methodHandle = GCHandle.Alloc(methodDelegate);
-            var methodFuncPtr = Marshal.GetFunctionPointerForDelegate(methodDelegate);
+            return ResolveConstructor(type, ctor, signature, prepareMode);
+        }
 
-            var delegateRef = new DelegateRef(methodHandle, methodFuncPtr);
-            DelegateRefs.TryAdd(methodFuncPtr, (type, ctor, delegateRef));
-            DelegatesByMethod.TryAdd((type, ctor), delegateRef);
-            return methodFuncPtr;
+        private static IntPtr ResolveConstructor(
+            Type type,
+            ConstructorInfo ctor,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            RecordResolve(ProfileEntryKind.Constructor, type, ctor, signature.Parameters);
+
+            // Trampolines call the constructor directly; otherwise, a proxy method is needed
+            // for the marshaling delegate
+            MethodInfo ctorProxy = null;
+            DelegateRef delegateRef;
+            var trampoline = CodeGenerator.CreateTrampoline(ctor, signature);
+            if (trampoline != IntPtr.Zero) {
+                delegateRef = new DelegateRef(ctor, trampoline);
+            } else {
+                ctorProxy = CodeGenerator.CreateProxyMethodForCtor(ctor, signature)
+                    ?? throw new ArgumentException("Error getting ctor delegate", "parameters");
+                delegateRef = CreateMarshalingDelegateRef(
+                    ctorProxy, signature, "Error getting ctor delegate", "parameters");
+            }
+            AddDelegateRef(type, ctor, delegateRef);
+            PrepareMethods(prepareMode, ctor, ctorProxy);
+            return delegateRef.FuncPtr;
         }
 
         public static IntPtr ResolveInstanceMethod(
@@ -108,41 +171,188 @@ namespace Qt.DotNet
             // Compile-time signature check of delegate vs. method
             _ = new Delegates.ResolveInstanceMethod(ResolveInstanceMethod);
 #endif
+            var prepareMode = TakePrepareMode(parameters);
+            return ResolveInstanceMethod(
+                objRefPtr, methodName, Signature.Get(parameters), prepareMode);
+        }
+
+        /// <summary>
+        /// Resolve an instance method with a registered signature (see RegisterSignature()).
+        /// </summary>
+        /// <param name="objRefPtr">Target object reference</param>
+        /// <param name="methodName">Name of the method</param>
+        /// <param name="signatureId">ID of the signature of the method</param>
+        /// <param name="prepareMode">PrepareMode value</param>
+        /// <returns>Function pointer</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static IntPtr ResolveInstanceMethodById(
+            IntPtr objRefPtr,
+            string methodName,
+            int signatureId,
+            int prepareMode)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveInstanceMethodById(ResolveInstanceMethodById);
+#endif
+            return ResolveInstanceMethod(
+                objRefPtr, methodName, Signature.Get(signatureId), GetPrepareMode(prepareMode));
+        }
 
+        private static IntPtr ResolveInstanceMethod(
+            IntPtr objRefPtr,
+            string methodName,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
             var objRef = GetObjectRefFromPtr(objRefPtr);
             if (objRef == null)
                 throw new ArgumentException("Invalid object reference", nameof(objRefPtr));
             var obj = objRef.Target;
             var type = obj.GetType();
-            var parameterTypes = parameters
-                .Skip(1)
-                .Select((x, i) => x.GetParameterType()
-                    ?? throw new ArgumentException($"Type not found [{i}]", nameof(parameters)))
-                .ToArray();
+            var parameterTypes = signature.GetParameterTypes(1);
 
             var method = type.GetMethod(
                 methodName, BindingFlags.Public | BindingFlags.Instance, parameterTypes)
                 ?? throw new ArgumentException(
                     $"Method '{methodName}' not found", nameof(methodName));
 
+            return ResolveInstanceMethod(obj, method, signature, prepareMode);
+        }
+
+        private static IntPtr ResolveInstanceMethod(
+            object obj,
+            MethodInfo method,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            var type = obj.GetType();
+            RecordResolve(ProfileEntryKind.Instance, type, method, signature.Parameters);
             if (DelegatesByMethod.TryGetValue((obj, method), out var objMethod))
                 return objMethod.FuncPtr;
 
-            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(method, parameters)
-                ?? throw new ArgumentException("Error getting method delegate", nameof(methodName));
+            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(method, signature)
+                ?? throw new ArgumentException("Error getting method delegate", "methodName");
 
             var methodDelegate = Delegate.CreateDelegate(delegateType, obj, method, false)
-                ?? throw new ArgumentException("Error getting method delegate", nameof(methodName));
+                ?? throw new ArgumentException("Error getting method delegate", "methodName");
 
             var methodHandle = GCHandle.Alloc(methodDelegate);
             var methodFuncPtr = Marshal.GetFunctionPointerForDelegate(methodDelegate);
 
             var delegateRef = new DelegateRef(methodHandle, methodFuncPtr);
-            DelegateRefs.TryAdd(methodFuncPtr, (obj, method, delegateRef));
-            DelegatesByMethod.TryAdd((obj, method), delegateRef);
+            AddDelegateRef(obj, method, delegateRef);
+            PrepareMethods(prepareMode, method);
             return methodFuncPtr;
         }
 
+        /// <summary>
+        /// Resolve an instance method as an open-instance delegate, i.e. a function that takes
+        /// the target object as its first argument and that is shared by all objects of a type.
+        /// </summary>
+        /// <param name="typeName">Type that declares or inherits the method</param>
+        /// <param name="methodName">Name of the method</param>
+        /// <param name="parameterCount">Number of elements in parameters</param>
+        /// <param name="parameters">Return type, followed by the target object (an object
+        /// reference of type typeName) and the method's parameters</param>
+        /// <returns>Function pointer</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static IntPtr ResolveOpenInstanceMethod(
+            string typeName,
+            string methodName,
+            int parameterCount,
+            Parameter[] parameters)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveOpenInstanceMethod(ResolveOpenInstanceMethod);
+#endif
+            var prepareMode = TakePrepareMode(parameters);
+            return ResolveOpenInstanceMethod(
+                typeName, methodName, Signature.Get(parameters), prepareMode);
+        }
+
+        /// <summary>
+        /// Resolve an instance method as an open-instance delegate (see
+        /// ResolveOpenInstanceMethod()), with a registered signature (see RegisterSignature()).
+        /// </summary>
+        /// <param name="typeName">Type that declares or inherits the method</param>
+        /// <param name="methodName">Name of the method</param>
+        /// <param name="signatureId">ID of the signature of the method, including the target
+        /// object</param>
+        /// <param name="prepareMode">PrepareMode value</param>
+        /// <returns>Function pointer</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static IntPtr ResolveOpenInstanceMethodById(
+            string typeName,
+            string methodName,
+            int signatureId,
+            int prepareMode)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveOpenInstanceMethodById(ResolveOpenInstanceMethodById);
+#endif
+            return ResolveOpenInstanceMethod(
+                typeName, methodName, Signature.Get(signatureId), GetPrepareMode(prepareMode));
+        }
+
+        private static IntPtr ResolveOpenInstanceMethod(
+            string typeName,
+            string methodName,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            if (signature.Length < 2)
+                throw new ArgumentException("Missing target object param", "parameters");
+
+            var type = TypeCache.GetType(typeName)
+                ?? throw new ArgumentException($"Type '{typeName}' not found", nameof(typeName));
+
+            var sigTypes = signature.GetParameterTypes(2);
+
+            var method = type.GetMethod(
+                methodName, BindingFlags.Public | BindingFlags.Instance, sigTypes)
+                ?? throw new ArgumentException(
+                    $"Method '{methodName}' not found", nameof(methodName));
+
+            return ResolveOpenInstanceMethod(type, method, signature, prepareMode);
+        }
+
+        private static IntPtr ResolveOpenInstanceMethod(
+            Type type,
+            MethodInfo method,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            // The generated proxy must be able to access the method's declaring type
+            if (method.DeclaringType is not { IsVisible: true }) {
+                throw new ArgumentException(
+                    $"Method '{method.Name}' not accessible", "methodName");
+            }
+
+            RecordResolve(ProfileEntryKind.OpenInstance, type, method, signature.Parameters);
+            if (DelegatesByMethod.TryGetValue((type, method), out var typeMethod))
+                return typeMethod.FuncPtr;
+
+            // Trampolines take the target object as first argument; otherwise, a proxy method is
+            // needed for the marshaling delegate
+            MethodInfo methodProxy = null;
+            DelegateRef delegateRef;
+            var trampoline = CodeGenerator.CreateTrampoline(method, signature);
+            if (trampoline != IntPtr.Zero) {
+                delegateRef = new DelegateRef(method, trampoline);
+            } else {
+                methodProxy = CodeGenerator.CreateProxyMethodForInstanceMethod(method, signature)
+                    ?? throw new ArgumentException("Error getting method proxy", "methodName");
+                delegateRef = CreateMarshalingDelegateRef(
+                    methodProxy, signature, "Error getting method delegate", "methodName");
+            }
+            AddDelegateRef(type, method, delegateRef);
+            PrepareMethods(prepareMode, method, methodProxy);
+            return delegateRef.FuncPtr;
+        }
+
         public static IntPtr ResolveSafeMethod(
             IntPtr funcPtr,
             int parameterCount,
@@ -152,29 +362,145 @@ namespace Qt.DotNet
             // Compile-time signature check of delegate vs. method
             _ = new Delegates.ResolveSafeMethod(ResolveSafeMethod);
 #endif
-            var delegateHandle = DelegateRefs.Values
-                .Where(x => x.Ref.FuncPtr == funcPtr)
-                .Select(x => x.Ref.Handle)
-                .FirstOrDefault();
+            var prepareMode = TakePrepareMode(parameters);
+            return ResolveSafeMethod(funcPtr, Signature.Get(parameters), prepareMode);
+        }
 
-            var funcDelegate = delegateHandle.Target as Delegate;
+        /// <summary>
+        /// Resolve the safe wrapper of a method (see ResolveSafeMethod()), with a registered
+        /// signature (see RegisterSignature()).
+        /// </summary>
+        /// <param name="funcPtr">Function pointer of the resolved method</param>
+        /// <param name="signatureId">ID of the signature of the safe wrapper</param>
+        /// <param name="prepareMode">PrepareMode value</param>
+        /// <returns>Function pointer</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static IntPtr ResolveSafeMethodById(IntPtr funcPtr, int signatureId, int prepareMode)
+        {
 #if DEBUG
-            Debug.Assert(funcDelegate != null, nameof(funcDelegate) + " is null");
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ResolveSafeMethodById(ResolveSafeMethodById);
 #endif
-            if (SafeMethods.TryGetValue(funcDelegate.Method, out var delegateRef))
+            return ResolveSafeMethod(
+                funcPtr, Signature.Get(signatureId), GetPrepareMode(prepareMode));
+        }
+
+        private static IntPtr ResolveSafeMethod(
+            IntPtr funcPtr,
+            Signature signature,
+            PrepareMode prepareMode)
+        {
+            if (!DelegateRefs.TryGetValue(funcPtr, out var funcRef))
+                throw new ArgumentException("Invalid function pointer", nameof(funcPtr));
+
+            var funcMethod = funcRef.Ref.Method;
+#if DEBUG
+            Debug.Assert(funcMethod != null, nameof(funcMethod) + " is null");
+#endif
+            // Constructors and open-instance delegates: call the constructor or instance method
+            // instead of the proxy method, with the target object in the first argument of the
+            // safe method
+            var unsafeMethod = funcRef.Method switch
+            {
+                ConstructorInfo ctor => ctor,
+                MethodInfo { IsStatic: false } instanceMethod when funcMethod.IsStatic
+                    => instanceMethod,
+                _ => funcMethod
+            };
+            if (SafeMethods.TryGetValue(unsafeMethod, out var delegateRef))
                 return delegateRef.FuncPtr;
 
-            var method = CodeGenerator.CreateSafeMethod(funcDelegate.Method);
-            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(method, parameters);
-            var methodDelegate = Delegate.CreateDelegate(delegateType, method);
+            var method = CodeGenerator.CreateSafeMethod(unsafeMethod);
+            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(method, signature);
+            var methodDelegate = method.CreateDelegate(delegateType);
             var methodHandle = GCHandle.Alloc(methodDelegate);
             var methodFuncPtr = Marshal.GetFunctionPointerForDelegate(methodDelegate);
 
             delegateRef = new DelegateRef(methodHandle, methodFuncPtr);
-            SafeMethods.TryAdd(funcDelegate.Method, delegateRef);
+            var cachedRef = SafeMethods.GetOrAdd(unsafeMethod, delegateRef);
+            if (cachedRef != delegateRef) {
+                // Resolved concurrently by another thread
+                methodHandle.Free();
+                return cachedRef.FuncPtr;
+            }
+            PrepareMethods(prepareMode, method);
             return methodFuncPtr;
         }
 
+        /// <summary>
+        /// Get a function pointer to a static method (or generated proxy method). If all
+        /// parameters are primitives or object references, this is a trampoline that native code
+        /// calls with no interop marshaling (see CodeGenerator.CreateTrampoline()); otherwise, it
+        /// is the function pointer of a marshaling delegate.
+        /// </summary>
+        /// <exception cref="ArgumentException"></exception>
+        private static DelegateRef CreateStaticDelegateRef(
+            MethodInfo method,
+            Signature signature,
+            string errorMessage,
+            string paramName)
+        {
+            var trampoline = CodeGenerator.CreateTrampoline(method, signature);
+            if (trampoline != IntPtr.Zero)
+                return new DelegateRef(method, trampoline);
+            return CreateMarshalingDelegateRef(method, signature, errorMessage, paramName);
+        }
+
+        /// <summary>
+        /// Get the function pointer of a marshaling delegate that calls a static method (or
+        /// generated proxy method).
+        /// </summary>
+        /// <exception cref="ArgumentException"></exception>
+        private static DelegateRef CreateMarshalingDelegateRef(
+            MethodInfo method,
+            Signature signature,
+            string errorMessage,
+            string paramName)
+        {
+            var delegateType = CodeGenerator.CreateDelegateTypeForMethod(method, signature)
+                ?? throw new ArgumentException(errorMessage, paramName);
+
+            // Also supports lightweight methods (i.e. DynamicMethod), unlike
+            // Delegate.CreateDelegate()
+            var methodDelegate = method.CreateDelegate(delegateType)
+                ?? throw new ArgumentException(errorMessage, paramName);
+
+            var methodHandle = GCHandle.Alloc(methodDelegate);
+            var methodFuncPtr = Marshal.GetFunctionPointerForDelegate(methodDelegate);
+            return new DelegateRef(methodHandle, methodFuncPtr);
+        }
+
+        /// <summary>
+        /// Keep track of a resolved method. Trampolines are shared, so the function pointer of a
+        /// trampoline might already be tracked for another target; in that case, the method is
+        /// not added to the by-method index, and later resolves will not use it.
+        /// </summary>
+        private static void AddDelegateRef(object target, MethodBase method, DelegateRef delegateRef)
+        {
+            if (!DelegateRefs.TryAdd(delegateRef.FuncPtr, (target, method, delegateRef)))
+                return;
+            DelegatesByMethod.TryAdd((target, method), delegateRef);
+            UpdateTargetRefs(target, true, x => x.Delegates.Add(delegateRef.FuncPtr));
+        }
+
+        /// <summary>
+        /// Register the signature of a method, i.e. the parameter info of the return type
+        /// followed by the parameter info of each argument. Methods with the same signature can
+        /// then be resolved by signature ID (e.g. ResolveStaticMethodById()), with no parameter
+        /// info being passed. Registering an equal signature again returns the same ID.
+        /// </summary>
+        /// <param name="parameterCount">Number of elements in parameters</param>
+        /// <param name="parameters">Parameter info (prepare mode is ignored)</param>
+        /// <returns>Signature ID (greater than zero)</returns>
+        public static int RegisterSignature(int parameterCount, Parameter[] parameters)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.RegisterSignature(RegisterSignature);
+#endif
+            return Signature.Get(parameters).Id;
+        }
+
         private static ConcurrentDictionary
             <MethodBase, DelegateRef> SafeMethods
         { get; } = new();
@@ -4,6 +4,7 @@
 ***************************************************************************************************/
 
 using System.Reflection;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 
 namespace Qt.DotNet
@@ -14,7 +15,7 @@ namespace Qt.DotNet
         {
             var objHandle = GCHandle.Alloc(obj, weakRef ? GCHandleType.Weak : GCHandleType.Normal);
             var objRefPtr = GCHandle.ToIntPtr(objHandle);
-            ObjectRefs.TryAdd(objRefPtr, new ObjectRef(objHandle));
+            RegisterObjectRef(objRefPtr, new ObjectRef(objHandle, weakRef));
             return objRefPtr;
         }
 
@@ -49,12 +50,14 @@ namespace Qt.DotNet
             var objHandle = GCHandle.Alloc(
                 obj, weakRef ? GCHandleType.Weak : GCHandleType.Normal);
             var newObjRefPtr = GCHandle.ToIntPtr(objHandle);
-            ObjectRefs.TryAdd(newObjRefPtr, new ObjectRef(objHandle));
+            RegisterObjectRef(newObjRefPtr, new ObjectRef(objHandle, weakRef));
             return newObjRefPtr;
         }
 
         /// <summary>
-        /// Release object reference, as well as any associated instance method and event references
+        /// Release object reference, as well as any associated instance method and event
+        /// references. Instance methods are released with the last strong ref. to the object;
+        /// weak refs. do not keep them alive.
         /// </summary>
         /// <param name="objRefPtr">Native reference to target object.</param>
         /// <returns>'true' if object ref. was released successfully; 'false' otherwise</returns>
@@ -67,18 +70,23 @@ namespace Qt.DotNet
 #endif
             if (!ObjectRefs.TryRemove(objRefPtr, out var objRef))
                 throw new ArgumentException("Invalid object reference", nameof(objRefPtr));
+            if (objRef.IsWeak)
+                WeakObjectRefs.TryRemove(objRefPtr, out _);
             RemoveAllEventHandlers(objRef);
 
-            var liveObjects = ObjectRefs.Values.Select(x => x.Target).ToList();
-            var isLive = liveObjects.Any(x => x.Equals(objRef.Target));
-            if (!isLive) {
-                var deadMethods = DelegatesByMethod
-                    .Where(x => x.Key.Target.Equals(objRef.Target))
-                    .Select(x => x.Value.FuncPtr)
-                    .ToList();
-                deadMethods.ForEach(FreeDelegateRef);
+            if (objRef.Target is { } target) {
+                IntPtr[] deadMethods = null;
+                UpdateTargetRefs(target, false, x =>
+                {
+                    x.ObjectRefs.Remove(objRefPtr);
+                    if (x.ObjectRefs.Count == 0)
+                        deadMethods = x.Delegates.ToArray();
+                });
+                if (deadMethods != null)
+                    Array.ForEach(deadMethods, FreeDelegateRef);
             }
 
+            NotifyRefFreed(RefKind.Object, objRefPtr);
             objRef.Handle.Free();
         }
 
@@ -93,20 +101,27 @@ namespace Qt.DotNet
             // Compile-time signature check of delegate vs. method
             _ = new Delegates.FreeTypeRef(FreeTypeRef);
 #endif
-            var type = Type.GetType(typeName)
+            var type = TypeCache.GetType(typeName)
                 ?? throw new ArgumentException($"Type '{typeName}' not found", nameof(typeName));
 
-            var typeRefs = ObjectRefs
-                .Where(x => x.Value.Target.Equals(type))
+            IntPtr[] typeRefs = null;
+            UpdateTargetRefs(type, false, x => typeRefs = x.ObjectRefs.ToArray());
+            if (typeRefs != null)
+                Array.ForEach(typeRefs, FreeObjectRef);
+            // The targets of weak refs might have been collected
+            var weakTypeRefs = WeakObjectRefs
+                .Where(x => Equals(x.Value.Target, type))
+                .Select(x => x.Key)
                 .ToList();
-            foreach (var typeRef in typeRefs)
-                FreeObjectRef(typeRef.Key);
+            weakTypeRefs.ForEach(FreeObjectRef);
 
-            var deadMethods = DelegatesByMethod
-                .Where(x => x.Key.Target.Equals(type))
-                .Select(x => x.Value.FuncPtr)
-                .ToList();
-            deadMethods.ForEach(FreeDelegateRef);
+            IntPtr[] deadMethods = null;
+            UpdateTargetRefs(type, false, x => deadMethods = x.Delegates.ToArray());
+            if (deadMethods != null)
+                Array.ForEach(deadMethods, FreeDelegateRef);
+
+            FreeSafeMethods(type);
+            CodeGenerator.Release(type);
         }
 
         public static void FreeDelegateRef(IntPtr delRefPtr)
@@ -118,7 +133,106 @@ namespace Qt.DotNet
             if (!DelegateRefs.TryRemove(delRefPtr, out var delegateRef))
                 return;
             DelegatesByMethod.TryRemove((delegateRef.Target, delegateRef.Method), out _);
-            delegateRef.Ref.Handle.Free();
+            if (delegateRef.Target != null)
+                UpdateTargetRefs(delegateRef.Target, false, x => x.Delegates.Remove(delRefPtr));
+            NotifyRefFreed(RefKind.Delegate, delRefPtr);
+            // Trampolines are shared and kept by the code generator; no handle to release
+            if (delegateRef.Ref.Handle.IsAllocated)
+                delegateRef.Ref.Handle.Free();
+        }
+
+        /// <summary>
+        /// Release the safe wrappers (see ResolveSafeMethod()) of the methods and constructors
+        /// of a type, so that the generated code can be collected.
+        /// </summary>
+        private static void FreeSafeMethods(Type type)
+        {
+            var deadMethods = SafeMethods.Keys
+                .Where(x => x.ReflectedType == type)
+                .ToList();
+            foreach (var method in deadMethods) {
+                if (!SafeMethods.TryRemove(method, out var delegateRef))
+                    continue;
+                NotifyRefFreed(RefKind.Delegate, delegateRef.FuncPtr);
+                delegateRef.Handle.Free();
+            }
+        }
+
+        /// <summary>
+        /// Add a new object ref., and index it by target (strong refs.) or as a weak ref.
+        /// </summary>
+        private static void RegisterObjectRef(IntPtr objRefPtr, ObjectRef objRef)
+        {
+            ObjectRefs.TryAdd(objRefPtr, objRef);
+            if (objRef.IsWeak)
+                WeakObjectRefs.TryAdd(objRefPtr, objRef);
+            else if (objRef.Target is { } target)
+                UpdateTargetRefs(target, true, x => x.ObjectRefs.Add(objRefPtr));
+        }
+
+        /// <summary>
+        /// Update the index entry of a target object. The entry is removed once the target has
+        /// no strong object refs. and no delegates.
+        /// </summary>
+        /// <param name="target">Target object</param>
+        /// <param name="add">'true' to create the entry if needed; 'false' to skip the update
+        /// if there is no entry</param>
+        /// <param name="update">Update to apply, while holding the lock on the entry</param>
+        private static void UpdateTargetRefs(object target, bool add, Action<TargetRefs> update)
+        {
+            while (true) {
+                TargetRefs refs;
+                if (add)
+                    refs = RefsByTarget.GetOrAdd(target, _ => new TargetRefs());
+                else if (!RefsByTarget.TryGetValue(target, out refs))
+                    return;
+                lock (refs) {
+                    // Entry being removed by another thread; retry with a new entry (if any)
+                    if (refs.IsRemoved)
+                        continue;
+                    update(refs);
+                    if (!refs.IsEmpty)
+                        return;
+                    refs.IsRemoved = true;
+                }
+                RefsByTarget.TryRemove(new KeyValuePair<object, TargetRefs>(target, refs));
+                return;
+            }
+        }
+
+        /// <summary>
+        /// Kind of reference passed to the native ref-freed callback
+        /// </summary>
+        public enum RefKind
+        {
+            Delegate,
+            Object
+        }
+
+        private static IntPtr RefFreedCallback = IntPtr.Zero;
+
+        /// <summary>
+        /// Set a native function to be called whenever a delegate ref. or an object ref. is
+        /// released, including refs released implicitly (e.g. the delegates of a type, when
+        /// freeing the type). The callback is called before the underlying handle is freed, so
+        /// the ref. cannot yet have been reused. Used to keep native caches of resolved methods
+        /// up-to-date.
+        /// </summary>
+        /// <param name="callback">Pointer to native function (RefKind, IntPtr), or null</param>
+        public static void SetRefFreedCallback(IntPtr callback)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.SetRefFreedCallback(SetRefFreedCallback);
+#endif
+            RefFreedCallback = callback;
+        }
+
+        private static unsafe void NotifyRefFreed(RefKind kind, IntPtr refPtr)
+        {
+            var callback = (delegate* unmanaged<int, IntPtr, void>)RefFreedCallback;
+            if (callback != null)
+                callback((int)kind, refPtr);
         }
 
         public static IntPtr GetObject(IntPtr objRefPtr, string path)
@@ -151,5 +265,26 @@ namespace Qt.DotNet
             }
             return GetRefPtrToObject(obj);
         }
+
+        private static ConditionalWeakTable<Type, string> TypeNames { get; } = new();
+
+        /// <summary>
+        /// Get the assembly-qualified name of the runtime type of an object
+        /// </summary>
+        /// <param name="objRefPtr">Native reference to target object</param>
+        /// <returns>Type name, or null if the object has no assembly-qualified type name</returns>
+        /// <exception cref="ArgumentException"></exception>
+        public static string GetObjectTypeName(IntPtr objRefPtr)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.GetObjectTypeName(GetObjectTypeName);
+#endif
+            var objRef = GetObjectRefFromPtr(objRefPtr);
+            if (objRef == null)
+                throw new ArgumentException("Invalid object reference", nameof(objRefPtr));
+            var type = objRef.Target.GetType();
+            return TypeNames.GetValue(type, x => x.AssemblyQualifiedName);
+        }
     }
 }
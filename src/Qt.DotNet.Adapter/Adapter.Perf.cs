@@ -0,0 +1,187 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+#if DEBUG || TESTS
+using System.Diagnostics;
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        /// <summary>
+        /// Micro-benchmarks of adapter functions. For debug/test purposes.
+        /// </summary>
+        public static class Perf
+        {
+            /// <summary>
+            /// Measure the cost of ResolveSafeMethod() for a method whose safe wrapper has
+            /// already been generated, i.e. the cost of constructing a QDotNetSafeMethod,
+            /// while the delegate table holds a given number of additional entries.
+            /// </summary>
+            /// <param name="delegateCount">Number of placeholder entries to add</param>
+            /// <param name="iterations">Number of calls to measure</param>
+            /// <returns>Average time per call, in nanoseconds</returns>
+            public static double ResolveSafeMethod(int delegateCount, int iterations = 10000)
+            {
+                var stringParam = new Parameter(UnmanagedType.LPWStr);
+                var objectParam = new Parameter("System.Object", (ulong)Parameter.ObjectRef);
+                var funcPtr = Adapter.ResolveStaticMethod("System.Environment",
+                    "GetEnvironmentVariable", 2, new[] { stringParam, stringParam });
+                // Safe method: SafeReturn<T> (object ref.), target object, method arguments
+                var parameters = new[] { objectParam, objectParam, stringParam };
+                var (target, method, _) = DelegateRefs[funcPtr];
+
+                // Placeholder keys are negative, so they cannot clash with function pointers
+                var placeholders = Enumerable.Range(1, delegateCount)
+                    .Select(i => new IntPtr(-i))
+                    .ToList();
+                try {
+                    foreach (var placeholder in placeholders) {
+                        DelegateRefs.TryAdd(placeholder,
+                            (target, method, new DelegateRef(default(GCHandle), placeholder)));
+                    }
+                    Adapter.ResolveSafeMethod(funcPtr, 3, parameters);
+
+                    var start = Stopwatch.GetTimestamp();
+                    for (int i = 0; i < iterations; ++i)
+                        Adapter.ResolveSafeMethod(funcPtr, 3, parameters);
+                    var elapsed = Stopwatch.GetTimestamp() - start;
+                    return elapsed * 1e9 / Stopwatch.Frequency / iterations;
+                } finally {
+                    foreach (var placeholder in placeholders)
+                        DelegateRefs.TryRemove(placeholder, out _);
+                    FreeTypeRef("System.Environment");
+                }
+            }
+
+            /// <summary>
+            /// Measure the cost of generating safe wrappers (see CodeGenerator.CreateSafeMethod()),
+            /// including the creation of a delegate for each wrapper, and the managed memory
+            /// allocated and retained after the wrappers are released.
+            /// </summary>
+            /// <param name="count">Number of wrappers to generate</param>
+            /// <returns>Generation time, in milliseconds, and allocated and retained memory, in
+            /// bytes</returns>
+            public static (double Milliseconds, long AllocatedBytes, long RetainedBytes)
+                GenerateSafeMethods(int count = 1000)
+            {
+                var method = typeof(Environment).GetMethod(
+                    nameof(Environment.GetEnvironmentVariable), new[] { typeof(string) });
+                // Warm-up, with as many wrappers as measured: the runtime's bookkeeping of
+                // lightweight methods grows once, and is then reused
+                Generate(method, count);
+
+                var memory = GC.GetTotalMemory(true);
+                var allocated = GC.GetAllocatedBytesForCurrentThread();
+                var start = Stopwatch.GetTimestamp();
+                Generate(method, count);
+                var elapsed = Stopwatch.GetTimestamp() - start;
+                allocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+                var retained = GC.GetTotalMemory(true) - memory;
+                return (elapsed * 1e3 / Stopwatch.Frequency, allocated, retained);
+
+                static void Generate(MethodInfo method, int count)
+                {
+                    var delegates = new Delegate[count];
+                    for (int i = 0; i < count; ++i) {
+                        delegates[i] = CodeGenerator.CreateSafeMethod(method)
+                            .CreateDelegate<Func<object, string, SafeReturn<string>>>();
+                    }
+                    GC.KeepAlive(delegates);
+                }
+            }
+
+            /// <summary>
+            /// Measure the cost of resolving a method that was already resolved, as called from
+            /// native code, with the method's signature passed either as parameter info or as
+            /// a registered signature ID.
+            /// </summary>
+            /// <param name="byId">Resolve with a signature ID</param>
+            /// <param name="iterations">Number of calls to measure, after as many warm-up calls
+            /// </param>
+            /// <returns>Average time per call, in nanoseconds</returns>
+            public static unsafe double ResolveStaticMethod(bool byId, int iterations = 100_000)
+            {
+                delegate* unmanaged<char*, int, char*, int, int, NativeParameter*, IntPtr>
+                    resolve = &Unmanaged.ResolveStaticMethod;
+                delegate* unmanaged<char*, int, char*, int, int, int, IntPtr>
+                    resolveById = &Unmanaged.ResolveStaticMethodById;
+                delegate* unmanaged<int, NativeParameter*, int>
+                    registerSignature = &Unmanaged.RegisterSignature;
+
+                const string typeName = "System.String";
+                const string methodName = "Concat";
+                const string stringTypeName = "System.String";
+                fixed (char* typeNamePtr = typeName, methodNamePtr = methodName,
+                    stringTypeNamePtr = stringTypeName) {
+                    var stringParam = new NativeParameter
+                    {
+                        TypeName = (IntPtr)stringTypeNamePtr,
+                        ParamInfo = (ulong)UnmanagedType.LPWStr
+                    };
+                    var parameters = stackalloc[] { stringParam, stringParam, stringParam };
+                    var signatureId = registerSignature(3, parameters);
+                    try {
+                        var funcPtr = resolve(typeNamePtr, typeName.Length,
+                            methodNamePtr, methodName.Length, 3, parameters);
+                        if (funcPtr == IntPtr.Zero || signatureId == 0)
+                            return double.NaN;
+
+                        // First pass is a warm-up, so that tiered compilation of the resolve
+                        // path is not measured
+                        long elapsed = 0;
+                        for (int pass = 0; pass < 2; ++pass) {
+                            var start = Stopwatch.GetTimestamp();
+                            for (int i = 0; i < iterations; ++i) {
+                                var result = byId
+                                    ? resolveById(typeNamePtr, typeName.Length,
+                                        methodNamePtr, methodName.Length, signatureId, 0)
+                                    : resolve(typeNamePtr, typeName.Length,
+                                        methodNamePtr, methodName.Length, 3, parameters);
+                                if (result != funcPtr)
+                                    return double.NaN;
+                            }
+                            elapsed = Stopwatch.GetTimestamp() - start;
+                        }
+                        return elapsed * 1e9 / Stopwatch.Frequency / iterations;
+                    } finally {
+                        FreeTypeRef(typeName);
+                    }
+                }
+            }
+
+            /// <summary>
+            /// Measure the cost of FreeObjectRef(), while all refs are still live, i.e. starting
+            /// with refs to the given number of objects. Each object has a resolved instance
+            /// method, which is released with the last ref. to the object; every other object
+            /// has a second ref.
+            /// </summary>
+            /// <param name="count">Number of objects</param>
+            /// <returns>Average time per call, in nanoseconds</returns>
+            public static double FreeObjectRefs(int count = 100_000)
+            {
+                var returnsInt = new[] { new Parameter(UnmanagedType.I4) };
+                var objRefs = new List<IntPtr>(count + count / 2);
+                for (int i = 0; i < count; ++i) {
+                    var objRef = GetRefPtrToObject(new object());
+                    objRefs.Add(objRef);
+                    if (i % 2 == 0)
+                        objRefs.Add(AddObjectRef(objRef));
+                    if (ResolveInstanceMethod(objRef, "GetHashCode", 1, returnsInt) == IntPtr.Zero)
+                        return double.NaN;
+                }
+
+                var start = Stopwatch.GetTimestamp();
+                foreach (var objRef in objRefs)
+                    FreeObjectRef(objRef);
+                var elapsed = Stopwatch.GetTimestamp() - start;
+                return elapsed * 1e9 / Stopwatch.Frequency / objRefs.Count;
+            }
+        }
+    }
+}
+#endif
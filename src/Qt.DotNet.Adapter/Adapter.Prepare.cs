@@ -0,0 +1,159 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Diagnostics;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        /// <summary>
+        /// JIT pre-compilation of resolved methods (see QDotNetAdapter::PrepareMode).
+        /// </summary>
+        public enum PrepareMode
+        {
+            /// <summary>Use the global mode (per-resolve setting only)</summary>
+            Default = 0,
+            /// <summary>Methods are compiled on first call</summary>
+            Off = 1,
+            /// <summary>Methods are compiled when resolved</summary>
+            Sync = 2,
+            /// <summary>Methods are compiled in a thread pool thread after being resolved</summary>
+            Background = 3
+        }
+
+        /// <summary>
+        /// Adapter counters (see QDotNetAdapter::Counter). New counters are appended to the end.
+        /// </summary>
+        public enum Counter
+        {
+            PreparedMethods,
+            PrepareFailures,
+            PrepareMicroseconds,
+            TypeCacheHits,
+            TypeCacheMisses,
+            GeneratedTypes,
+            GeneratedMethods,
+            LiveGeneratedCode,
+            EvictedGeneratedCode,
+            Count
+        }
+
+        private static volatile PrepareMode GlobalPrepareMode = PrepareMode.Off;
+
+        private static long[] Counters { get; } = new long[(int)Counter.Count];
+
+        internal static void IncrementCounter(Counter counter, long value = 1)
+        {
+            Interlocked.Add(ref Counters[(int)counter], value);
+        }
+
+        /// <summary>
+        /// Set the JIT pre-compilation mode for methods resolved from now on, unless a mode is
+        /// requested when resolving (i.e. in the parameter info of the return type).
+        /// </summary>
+        /// <param name="mode">PrepareMode value (Default is the same as Off)</param>
+        public static void SetPrepareMode(int mode)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.SetPrepareMode(SetPrepareMode);
+#endif
+            GlobalPrepareMode = Enum.IsDefined(typeof(PrepareMode), mode)
+                && (PrepareMode)mode != PrepareMode.Default
+                ? (PrepareMode)mode
+                : PrepareMode.Off;
+        }
+
+        /// <summary>
+        /// Get the current values of the adapter counters
+        /// </summary>
+        /// <param name="counters">Pointer to a native array of 64-bit integers</param>
+        /// <param name="count">Size of the native array; extra counters are left out</param>
+        /// <returns>Number of counters available</returns>
+        public static int GetCounters(IntPtr counters, int count)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.GetCounters(GetCounters);
+#endif
+            // Current number of entries, rather than a running total
+            Interlocked.Exchange(
+                ref Counters[(int)Counter.LiveGeneratedCode], CodeGenerator.CachedCount);
+            if (counters != IntPtr.Zero) {
+                for (int i = 0; i < Math.Min(count, Counters.Length); ++i) {
+                    var value = Interlocked.Read(ref Counters[i]);
+                    Marshal.WriteInt64(counters, i * sizeof(long), value);
+                }
+            }
+            return Counters.Length;
+        }
+
+        /// <summary>
+        /// Remove the prepare mode from the parameter info of the return type, so that it does
+        /// not take part in the lookup of generated code.
+        /// </summary>
+        /// <returns>Prepare mode for the method being resolved</returns>
+        private static PrepareMode TakePrepareMode(Parameter[] parameters)
+        {
+            if (parameters == null || parameters.Length == 0)
+                return GlobalPrepareMode;
+            var mode = (PrepareMode)parameters[0].PrepareMode;
+            if (mode == PrepareMode.Default)
+                return GlobalPrepareMode;
+            parameters[0] = parameters[0].WithPrepareMode((int)PrepareMode.Default);
+            return mode;
+        }
+
+        /// <summary>
+        /// Get the prepare mode requested when resolving a method by signature ID.
+        /// </summary>
+        /// <param name="mode">PrepareMode value (Default means the global mode)</param>
+        /// <returns>Prepare mode for the method being resolved</returns>
+        private static PrepareMode GetPrepareMode(int mode)
+        {
+            return Enum.IsDefined(typeof(PrepareMode), mode)
+                && (PrepareMode)mode != PrepareMode.Default
+                ? (PrepareMode)mode
+                : GlobalPrepareMode;
+        }
+
+        private static void PrepareMethods(PrepareMode mode, params MethodBase[] methods)
+        {
+            switch (mode) {
+            case PrepareMode.Sync:
+                PrepareMethods(methods);
+                break;
+            case PrepareMode.Background:
+                ThreadPool.QueueUserWorkItem(_ => PrepareMethods(methods));
+                break;
+            }
+        }
+
+        private static void PrepareMethods(MethodBase[] methods)
+        {
+            var start = Stopwatch.GetTimestamp();
+            foreach (var method in methods) {
+                // Lightweight methods are compiled when their delegate is created
+                if (method is null or DynamicMethod)
+                    continue;
+                if (method.IsAbstract || method.ContainsGenericParameters)
+                    continue;
+                try {
+                    RuntimeHelpers.PrepareMethod(method.MethodHandle);
+                    IncrementCounter(Counter.PreparedMethods);
+                } catch (Exception) {
+                    IncrementCounter(Counter.PrepareFailures);
+                }
+            }
+            IncrementCounter(Counter.PrepareMicroseconds,
+                (Stopwatch.GetTimestamp() - start) * 1_000_000 / Stopwatch.Frequency);
+        }
+    }
+}
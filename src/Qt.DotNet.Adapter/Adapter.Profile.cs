@@ -0,0 +1,200 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Collections.Concurrent;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Text;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        // Profile file format: one resolved method per line, with tab-separated fields:
+        //   kind, type (assembly-qualified name), method name, parameter count,
+        //   then type name and parameter info for each parameter (incl. return type)
+        private const string ProfileHeader = "#qtdotnet-profile 1";
+        private const char ProfileSeparator = '\t';
+
+        private enum ProfileEntryKind { Static, Constructor, Instance, OpenInstance }
+
+        private static volatile bool IsProfiling;
+
+        private static ConcurrentDictionary<string, byte> ProfileIndex { get; } = new();
+        private static ConcurrentQueue<string> ProfileEntries { get; } = new();
+
+        /// <summary>
+        /// Start recording the signatures of all methods resolved from now on. Recorded
+        /// signatures can be saved to a profile file with SaveProfile().
+        /// </summary>
+        public static void StartProfile()
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.StartProfile(StartProfile);
+#endif
+            ProfileIndex.Clear();
+            ProfileEntries.Clear();
+            IsProfiling = true;
+        }
+
+        /// <summary>
+        /// Save the signatures of all methods resolved since StartProfile() was called.
+        /// </summary>
+        /// <param name="path">Path to the profile file</param>
+        /// <returns>'true' if the profile was saved; 'false' otherwise</returns>
+        public static bool SaveProfile(string path)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.SaveProfile(SaveProfile);
+#endif
+            if (!IsProfiling || string.IsNullOrEmpty(path))
+                return false;
+            var tempPath = $"{path}.{Environment.ProcessId}.tmp";
+            try {
+                File.WriteAllLines(tempPath, ProfileEntries.Prepend(ProfileHeader), Encoding.UTF8);
+                File.Move(tempPath, path, true);
+                return true;
+            } catch (Exception) {
+                File.Delete(tempPath);
+                return false;
+            }
+        }
+
+        /// <summary>
+        /// Pre-generate the delegate types and JIT-compile the target methods listed in a
+        /// profile file, so that resolving those methods later on is faster. Entries that can
+        /// no longer be resolved (e.g. methods that were removed) are ignored.
+        /// </summary>
+        /// <param name="path">Path to the profile file</param>
+        /// <returns>Number of methods prepared, or -1 if the profile could not be read</returns>
+        public static int ReplayProfile(string path)
+        {
+#if DEBUG
+            // Compile-time signature check of delegate vs. method
+            _ = new Delegates.ReplayProfile(ReplayProfile);
+#endif
+            string[] lines;
+            try {
+                lines = File.ReadAllLines(path, Encoding.UTF8);
+            } catch (Exception) {
+                return -1;
+            }
+            if (lines.Length == 0 || lines[0] != ProfileHeader)
+                return -1;
+
+            int count = 0;
+            foreach (var line in lines.Skip(1)) {
+                try {
+                    if (ReplayProfileEntry(line))
+                        ++count;
+                } catch (Exception) {
+                }
+            }
+            return count;
+        }
+
+        private static void RecordResolve(
+            ProfileEntryKind kind,
+            Type type,
+            MethodBase method,
+            Parameter[] parameters)
+        {
+            if (!IsProfiling || type.AssemblyQualifiedName is not { } typeName)
+                return;
+            var entry = new StringBuilder()
+                .Append(kind).Append(ProfileSeparator)
+                .Append(typeName).Append(ProfileSeparator)
+                .Append(method.Name).Append(ProfileSeparator)
+                .Append(parameters.Length);
+            foreach (var parameter in parameters) {
+                entry.Append(ProfileSeparator).Append(parameter.TypeName)
+                    .Append(ProfileSeparator).Append(parameter.ParamInfo);
+            }
+            var line = entry.ToString();
+            if (ProfileIndex.TryAdd(line, 0))
+                ProfileEntries.Enqueue(line);
+        }
+
+        private static bool ReplayProfileEntry(string line)
+        {
+            var fields = line.Split(ProfileSeparator);
+            if (fields.Length < 4
+                || !Enum.TryParse<ProfileEntryKind>(fields[0], out var kind)
+                || !int.TryParse(fields[3], out var parameterCount)
+                || parameterCount < 1
+                || fields.Length != 4 + 2 * parameterCount) {
+                return false;
+            }
+
+            var parameters = new Parameter[parameterCount];
+            for (int i = 0; i < parameterCount; ++i) {
+                if (!ulong.TryParse(fields[5 + 2 * i], out var paramInfo))
+                    return false;
+                parameters[i] = new Parameter(fields[4 + 2 * i], paramInfo);
+            }
+
+            var type = TypeCache.GetType(fields[1]);
+            if (type == null)
+                return false;
+            var sigTypes = parameters
+                .Skip(kind == ProfileEntryKind.OpenInstance ? 2 : 1)
+                .Select(x => x.GetParameterType())
+                .ToArray();
+            if (sigTypes.Any(x => x == null))
+                return false;
+
+            var signature = Signature.Get(parameters);
+            MethodBase target;
+            MethodInfo delegateMethod;
+            switch (kind) {
+            case ProfileEntryKind.Constructor:
+                var ctor = type.GetConstructor(sigTypes);
+                if (ctor == null)
+                    return false;
+                target = ctor;
+                // Constructors called through a trampoline need no proxy method
+                delegateMethod = CodeGenerator.CreateTrampoline(ctor, signature) == IntPtr.Zero
+                    ? CodeGenerator.CreateProxyMethodForCtor(ctor, signature)
+                    : null;
+                break;
+            case ProfileEntryKind.Static:
+            case ProfileEntryKind.Instance:
+                var flags = kind == ProfileEntryKind.Static
+                    ? BindingFlags.Public | BindingFlags.Static
+                    : BindingFlags.Public | BindingFlags.Instance;
+                var method = type.GetMethod(fields[2], flags, sigTypes);
+                if (method == null)
+                    return false;
+                target = method;
+                delegateMethod = method;
+                break;
+            case ProfileEntryKind.OpenInstance:
+                var openMethod = type.GetMethod(
+                    fields[2], BindingFlags.Public | BindingFlags.Instance, sigTypes);
+                if (openMethod == null || parameterCount < 2)
+                    return false;
+                target = openMethod;
+                // Methods called through a trampoline need no proxy method
+                var trampoline = CodeGenerator.CreateTrampoline(openMethod, signature);
+                delegateMethod = trampoline == IntPtr.Zero
+                    ? CodeGenerator.CreateProxyMethodForInstanceMethod(openMethod, signature)
+                    : null;
+                break;
+            default:
+                return false;
+            }
+
+            if (delegateMethod != null
+                && CodeGenerator.CreateDelegateTypeForMethod(delegateMethod, signature) == null) {
+                return false;
+            }
+            if (!target.IsAbstract && !target.ContainsGenericParameters)
+                RuntimeHelpers.PrepareMethod(target.MethodHandle);
+            return true;
+        }
+    }
+}
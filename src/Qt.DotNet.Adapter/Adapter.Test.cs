@@ -5,6 +5,7 @@
 
 using System.Diagnostics;
 using System.Reflection;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 
 namespace Qt.DotNet
@@ -58,16 +59,468 @@ namespace Qt.DotNet
                     .Invoke(GetObjectRefFromPtr(objRef).Target, new object[] { str });
             }
 
+            // Instance methods are kept until the last strong ref. to the object is released
+            FreeObjectRef(AddObjectRef(objRef));
+            FreeObjectRef(AddObjectRef(objRef, weakRef: true));
+            var methodsKept = DelegateRefs.ContainsKey(getBarPtr);
+
             RemoveAllEventHandlers(objRef);
             FreeObjectRef(objRef);
             FreeTypeRef("FooLib.Foo, FooLib");
 
-            bool ok = Events.IsEmpty;
+            bool ok = methodsKept && Events.IsEmpty;
             ok = ok && ObjectRefs.IsEmpty;
             ok = ok && DelegateRefs.IsEmpty;
+            ok = ok && TestFreeTypeRef();
+            ok = ok && TestBootstrap();
+            ok = ok && TestUnmanaged();
+            ok = ok && TestProfile();
+            ok = ok && TestPrepare();
+            ok = ok && TestOpenInstance();
+            ok = ok && TestTrampoline();
+            ok = ok && TestResolveMany();
+            ok = ok && TestTypeCache();
+            ok = ok && TestInteropCache();
+            ok = ok && TestGeneratedCode();
+            ok = ok && TestPerf();
             return ok;
         }
 
+        private static bool TestFreeTypeRef()
+        {
+            [MethodImpl(MethodImplOptions.NoInlining)]
+            static IntPtr GetWeakRefToNewObject() => GetRefPtrToObject(new object(), true);
+
+            // Weak ref. whose target has been collected
+            var deadRef = GetWeakRefToNewObject();
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            if (ObjectRefs[deadRef].Target != null) {
+                FreeObjectRef(deadRef);
+                return false;
+            }
+
+            // Releasing a type releases its strong and weak refs, and no other refs
+            var type = typeof(System.Text.StringBuilder);
+            var typeRef = GetRefPtrToObject(type);
+            GetRefPtrToObject(type);
+            AddObjectRef(typeRef, weakRef: true);
+            FreeTypeRef(type.FullName);
+            bool ok = ObjectRefs.Count == 1 && ObjectRefs.ContainsKey(deadRef);
+            ok = ok && !RefsByTarget.ContainsKey(type);
+
+            FreeObjectRef(deadRef);
+            return ok && ObjectRefs.IsEmpty && WeakObjectRefs.IsEmpty;
+        }
+
+        private static bool TestPerf()
+        {
+            // Cost of constructing a safe method must not depend on the number of delegates
+            var baseline = Perf.ResolveSafeMethod(0);
+            var withDelegates = Perf.ResolveSafeMethod(100_000);
+            if (withDelegates >= 10 * Math.Max(baseline, 100))
+                return false;
+            // Resolving by signature ID returns the same function pointer
+            var byParameters = Perf.ResolveStaticMethod(byId: false);
+            var byId = Perf.ResolveStaticMethod(byId: true);
+            Console.WriteLine($"Resolve: {byParameters:F0} ns (parameters), {byId:F0} ns (ID)");
+            // Generated safe wrappers are collected once released
+            var (generateTime, allocated, retained) = Perf.GenerateSafeMethods(1000);
+            Console.WriteLine($"Generate: {generateTime:F1} ms, {allocated / 1024} KB allocated, "
+                + $"{retained / 1024} KB retained (1000 safe methods)");
+            if (retained >= allocated / 2)
+                return false;
+            // Cost of releasing an object ref. must not depend on the number of refs
+            var freeFew = Perf.FreeObjectRefs(1000);
+            var freeMany = Perf.FreeObjectRefs(100_000);
+            Console.WriteLine(
+                $"Free: {freeFew:F0} ns (1000 objects), {freeMany:F0} ns (100000 objects)");
+            if (double.IsNaN(freeFew) || double.IsNaN(freeMany))
+                return false;
+            if (freeMany >= 10 * Math.Max(freeFew, 100) || !RefsByTarget.IsEmpty)
+                return false;
+            return !double.IsNaN(byParameters) && !double.IsNaN(byId)
+                && ObjectRefs.IsEmpty && DelegateRefs.IsEmpty;
+        }
+
+        private static bool TestTypeCache()
+        {
+            static long Hits() => Interlocked.Read(ref Counters[(int)Counter.TypeCacheHits]);
+            static long Misses() => Interlocked.Read(ref Counters[(int)Counter.TypeCacheMisses]);
+
+            // Types not found are also kept
+            const string missingType = "Qt.DotNet.NoSuchType, Qt.DotNet.NoSuchAssembly";
+            var hits = Hits();
+            var misses = Misses();
+            bool ok = TypeCache.GetType(missingType) == null;
+            ok = ok && TypeCache.GetType(missingType) == null;
+            ok = ok && TypeCache.GetType("System.Math") == typeof(Math);
+            ok = ok && TypeCache.GetType("System.Math") == typeof(Math);
+            ok = ok && Hits() >= hits + 2 && Misses() <= misses + 2;
+
+            // Custom marshaler native type
+            ok = ok && TypeCache.GetCustomNativeType(typeof(Math)) == typeof(object);
+            return ok;
+        }
+
+        private static unsafe bool TestGeneratedCode()
+        {
+            static long Evicted()
+                => Interlocked.Read(ref Counters[(int)Counter.EvictedGeneratedCode]);
+
+            // Least recently used entry is evicted
+            var removed = new List<string>();
+            var cache = new LruCache<string, int>(2, (key, _) => removed.Add(key));
+            cache.TryAdd("a", 1);
+            cache.TryAdd("b", 2);
+            bool ok = cache.TryGetValue("a", out var a) && a == 1;
+            ok = ok && cache.GetOrAdd("c", 3) == 3 && !cache.TryGetValue("b", out _);
+            ok = ok && removed.SequenceEqual(new[] { "b" }) && cache.Count == 2;
+            ok = ok && cache.RemoveWhere((key, _) => key == "a") == 1 && cache.Count == 1;
+
+            // Open-instance method called through a trampoline
+            var intParam = new Parameter(UnmanagedType.I4);
+            var stringTarget = new Parameter("System.String", (ulong)Parameter.ObjectRef);
+            var getLength = (delegate* unmanaged<IntPtr, int>)ResolveOpenInstanceMethod(
+                "System.String", "get_Length", 2, new[] { intParam, stringTarget });
+            ok = ok && DelegateRefs[(IntPtr)getLength].Ref.IsTrampoline;
+            var objRef = GetRefPtrToObject("hello");
+            ok = ok && getLength(objRef) == 5;
+            FreeObjectRef(objRef);
+            FreeTypeRef("System.String");
+
+            // Lightweight proxy methods and safe wrappers are dropped when the type is released
+            const string typeName = "FooLib.Foo, FooLib";
+            var targetParam = new Parameter(typeName, (ulong)Parameter.ObjectRef);
+            var stringParam = new Parameter(UnmanagedType.LPWStr);
+            var objectParam = new Parameter("System.Object", (ulong)Parameter.ObjectRef);
+            var getBar = ResolveOpenInstanceMethod(
+                typeName, "get_Bar", 2, new[] { stringParam, targetParam });
+            ResolveSafeMethod(getBar, 2, new[] { objectParam, objectParam });
+            bool IsFooMethod(MethodBase x) => x.ReflectedType?.FullName == "FooLib.Foo";
+            ok = ok && SafeMethods.Keys.Any(IsFooMethod);
+            var evicted = Evicted();
+            FreeTypeRef(typeName);
+            ok = ok && Evicted() > evicted && !SafeMethods.Keys.Any(IsFooMethod);
+            return ok && ObjectRefs.IsEmpty && DelegateRefs.IsEmpty;
+        }
+
+        private static unsafe bool TestInteropCache()
+        {
+            const string typeName = "FooLib.Foo, FooLib";
+            var type = Type.GetType(typeName);
+            Debug.Assert(type != null, nameof(type) + " is null");
+            var stringParam = new Parameter(UnmanagedType.LPWStr);
+            var intParam = new Parameter(UnmanagedType.I4);
+            var objectParam = new Parameter(typeName, (ulong)Parameter.ObjectRef);
+
+            var format = type.GetMethod("FormatNumber");
+            var formatSig = new[] { stringParam, stringParam, intParam };
+            var ctor = type.GetConstructor(Type.EmptyTypes);
+            var ctorSig = new[] { objectParam };
+            var getBar = type.GetMethod("get_Bar");
+            var getBarSig = new[] { stringParam, objectParam };
+            Debug.Assert(format != null && ctor != null && getBar != null);
+
+            // Save generated code
+            var cache = new InteropCache.ModuleCache(
+                type.Module, $"QtDotNetInterop.Test.{Guid.NewGuid():N}");
+            bool ok = cache.Add(InteropCache.EntryKind.Delegate, format, formatSig);
+            ok = ok && cache.Add(InteropCache.EntryKind.Proxy, ctor, ctorSig);
+            ok = ok && cache.Add(InteropCache.EntryKind.Proxy, getBar, getBarSig);
+            ok = ok && !cache.Add(InteropCache.EntryKind.Delegate, format, formatSig);
+            // Static methods do not have open-instance proxies
+            ok = ok && !cache.Add(InteropCache.EntryKind.Proxy, format, formatSig);
+            var image = cache.Write();
+            ok = ok && !cache.IsModified;
+
+            // Load generated code, as in the next run
+            var loaded = new InteropCache.ModuleCache(
+                type.Module, $"QtDotNetInterop.Test.{Guid.NewGuid():N}");
+            ok = ok && loaded.Load(image) && loaded.Count == 3;
+            var formatType = loaded.GetDelegateType(format, formatSig);
+            ok = ok && formatType is { Assembly.IsDynamic: false }
+                && Delegate.CreateDelegate(formatType, format, false) != null;
+            ok = ok && loaded.GetDelegateType(format, new[] { stringParam, stringParam }) == null;
+
+            var newFoo = loaded.GetProxyMethod(ctor, ctorSig, out var ctorType, out var ctorTramp);
+            ok = ok && newFoo?.Invoke(null, null)?.GetType() == type && ctorType != null;
+            if (ok && ctorTramp != null) {
+                var newFooTramp = (delegate* unmanaged<IntPtr>)ctorTramp.MethodHandle
+                    .GetFunctionPointer();
+                var objRef = newFooTramp();
+                ok = GetObjectRefFromPtr(objRef)?.Target?.GetType() == type;
+                FreeObjectRef(objRef);
+            } else {
+                ok = false;
+            }
+
+            var foo = Activator.CreateInstance(type);
+            type.GetProperty("Bar")?.SetValue(foo, "bar");
+            var getBarProxy = loaded.GetProxyMethod(getBar, getBarSig, out var getBarType, out _);
+            ok = ok && getBarProxy?.Invoke(null, new[] { foo }) as string == "bar";
+            ok = ok && getBarType != null
+                && Delegate.CreateDelegate(getBarType, getBarProxy, false) != null;
+
+            // Loaded entries are saved again
+            ok = ok && loaded.Add(InteropCache.EntryKind.Delegate, getBar, new[] { stringParam });
+            var reloaded = new InteropCache.ModuleCache(
+                type.Module, $"QtDotNetInterop.Test.{Guid.NewGuid():N}");
+            ok = ok && reloaded.Load(loaded.Write()) && reloaded.Count == 4;
+            ok = ok && reloaded.GetDelegateType(getBar, new[] { stringParam }) != null;
+            return ok && ObjectRefs.IsEmpty;
+        }
+
+        private static bool TestResolveMany()
+        {
+            const string typeName = "FooLib.Foo, FooLib";
+            var intParam = new Parameter(UnmanagedType.I4);
+            var stringParam = new Parameter(UnmanagedType.LPWStr);
+            var maxId = RegisterSignature(3, new[] { intParam, intParam, intParam });
+            var formatId = RegisterSignature(3, new[] { stringParam, stringParam, intParam });
+            var ctorId = RegisterSignature(1, new[] { new Parameter(typeName) });
+            var getBarId = RegisterSignature(1, new[] { stringParam });
+            var requests = new[]
+            {
+                new ResolveRequest
+                {
+                    MethodName = "FormatNumber", Kind = (int)ResolveKind.Static,
+                    SignatureId = formatId
+                },
+                new ResolveRequest { Kind = (int)ResolveKind.Constructor, SignatureId = ctorId },
+                new ResolveRequest
+                {
+                    MethodName = "get_Bar", Kind = (int)ResolveKind.Instance,
+                    SignatureId = getBarId
+                },
+                new ResolveRequest
+                {
+                    MethodName = "Max", Kind = (int)ResolveKind.Static, SignatureId = maxId
+                },
+            };
+
+            var type = Type.GetType(typeName);
+            Debug.Assert(type != null, nameof(type) + " is null");
+            var objRef = GetRefPtrToObject(Activator.CreateInstance(type));
+            var funcPtrs = new IntPtr[requests.Length];
+            // Max is not a method of Foo
+            bool ok = ResolveMany(typeName, objRef, requests.Length, requests, funcPtrs) == 3;
+            ok = ok && funcPtrs[3] == IntPtr.Zero;
+            ok = ok && funcPtrs[0] == ResolveStaticMethodById(typeName, "FormatNumber", formatId, 0);
+            ok = ok && GetMethod(funcPtrs[1]) is ConstructorInfo;
+            ok = ok && funcPtrs[2] == ResolveInstanceMethodById(objRef, "get_Bar", getBarId, 0);
+
+            FreeObjectRef(objRef);
+            FreeTypeRef(typeName);
+            return ok && ObjectRefs.IsEmpty && DelegateRefs.IsEmpty;
+        }
+
+        private static unsafe bool TestTrampoline()
+        {
+            const string typeName = "FooLib.Foo, FooLib";
+            var intParam = new Parameter(UnmanagedType.I4);
+            var objectParam = new Parameter(typeName, (ulong)Parameter.ObjectRef);
+
+            // Primitives only: called through a trampoline
+            var max = (delegate* unmanaged<int, int, int>)ResolveStaticMethod(
+                "System.Math", "Max", 3, new[] { intParam, intParam, intParam });
+            bool ok = DelegateRefs[(IntPtr)max].Ref.IsTrampoline && max(-1, 42) == 42;
+
+            // Object reference returned as a handle
+            var newFoo = (delegate* unmanaged<IntPtr>)ResolveConstructor(1, new[] { objectParam });
+            ok = ok && DelegateRefs[(IntPtr)newFoo].Ref.IsTrampoline;
+            var objRef = newFoo();
+            ok = ok && GetObjectRefFromPtr(objRef)?.Target?.GetType() == Type.GetType(typeName);
+            FreeObjectRef(objRef);
+
+            // Strings are marshaled: called through a delegate
+            var stringParam = new Parameter(UnmanagedType.LPWStr);
+            var format = ResolveStaticMethod(
+                typeName, "FormatNumber", 3, new[] { stringParam, stringParam, intParam });
+            ok = ok && !DelegateRefs[format].Ref.IsTrampoline;
+
+            FreeTypeRef("System.Math");
+            FreeTypeRef(typeName);
+            return ok && ObjectRefs.IsEmpty && DelegateRefs.IsEmpty;
+        }
+
+        private static unsafe bool TestOpenInstance()
+        {
+            const string typeName = "FooLib.Foo, FooLib";
+            var targetParam = new Parameter(typeName, (ulong)Parameter.ObjectRef);
+            var stringParam = new Parameter(UnmanagedType.LPWStr);
+
+            var getBar = (delegate* unmanaged<IntPtr, IntPtr>)ResolveOpenInstanceMethod(
+                typeName, "get_Bar", 2, new[] { stringParam, targetParam });
+            var setBar = (delegate* unmanaged<IntPtr, char*, void>)ResolveOpenInstanceMethod(
+                typeName, "set_Bar", 3, new[] { new(), targetParam, stringParam });
+            if (getBar == null || setBar == null)
+                return false;
+            // Resolved once per type and method
+            if ((IntPtr)getBar != ResolveOpenInstanceMethod(
+                typeName, "get_Bar", 2, new[] { stringParam, targetParam })) {
+                return false;
+            }
+
+            var type = Type.GetType(typeName);
+            Debug.Assert(type != null, nameof(type) + " is null");
+            var objRefs = new[]
+            {
+                GetRefPtrToObject(Activator.CreateInstance(type)),
+                GetRefPtrToObject(Activator.CreateInstance(type))
+            };
+
+            // Runtime type name, as used to resolve open-instance methods
+            delegate* unmanaged<IntPtr, char*, int, int> getObjectTypeName
+                = &Unmanaged.GetObjectTypeName;
+            var typeNameLength = getObjectTypeName(objRefs[0], null, 0);
+            bool ok = typeNameLength == type.AssemblyQualifiedName?.Length;
+            var typeNameBuffer = new char[typeNameLength];
+            fixed (char* buffer = typeNameBuffer)
+                getObjectTypeName(objRefs[0], buffer, typeNameBuffer.Length);
+            ok = ok && Type.GetType(new string(typeNameBuffer)) == type;
+            for (int i = 0; i < objRefs.Length; ++i) {
+                fixed (char* bar = $"bar{i}")
+                    setBar(objRefs[i], bar);
+            }
+            for (int i = 0; i < objRefs.Length; ++i) {
+                var barPtr = getBar(objRefs[i]);
+                ok = ok && Marshal.PtrToStringUni(barPtr) == $"bar{i}";
+                Marshal.FreeCoTaskMem(barPtr);
+                FreeObjectRef(objRefs[i]);
+            }
+            FreeTypeRef(typeName);
+            return ok && ObjectRefs.IsEmpty && DelegateRefs.IsEmpty;
+        }
+
+        private static bool TestPrepare()
+        {
+            static long PreparedMethods()
+                => Interlocked.Read(ref Counters[(int)Counter.PreparedMethods]);
+            var stringParam = new Parameter(UnmanagedType.LPWStr);
+            var prepared = PreparedMethods();
+            try {
+                SetPrepareMode((int)PrepareMode.Sync);
+                ResolveStaticMethod("System.String", "Concat", 3,
+                    new[] { stringParam, stringParam, stringParam });
+                if (PreparedMethods() != prepared + 1)
+                    return false;
+
+                // Per-resolve mode, in the parameter info of the return type
+                SetPrepareMode((int)PrepareMode.Off);
+                var backgroundParam = stringParam.WithPrepareMode((int)PrepareMode.Background);
+                ResolveStaticMethod("System.String", "Copy", 2,
+                    new[] { backgroundParam, stringParam });
+                for (int i = 0; i < 100 && PreparedMethods() == prepared + 1; ++i)
+                    Thread.Sleep(10);
+                return PreparedMethods() == prepared + 2;
+            } finally {
+                SetPrepareMode((int)PrepareMode.Off);
+                FreeTypeRef("System.String");
+            }
+        }
+
+        private static bool TestProfile()
+        {
+            var path = Path.GetTempFileName();
+            try {
+                StartProfile();
+                ResolveConstructor(1, new[] { new Parameter("FooLib.Foo, FooLib") });
+                ResolveStaticMethod("System.Environment", "GetEnvironmentVariable", 2,
+                    new[] { new Parameter(UnmanagedType.LPWStr), new(UnmanagedType.LPWStr) });
+                FreeTypeRef("FooLib.Foo, FooLib");
+                FreeTypeRef("System.Environment");
+                if (!SaveProfile(path))
+                    return false;
+                File.AppendAllLines(path, new[] { "Static\tNo.Such.Type\tFoo\t1\t\t0" });
+                return ReplayProfile(path) == 2 && DelegateRefs.IsEmpty;
+            } finally {
+                IsProfiling = false;
+                File.Delete(path);
+            }
+        }
+
+        private static unsafe bool TestUnmanaged()
+        {
+            delegate* unmanaged<char*, int, byte> loadAssembly = &Unmanaged.LoadAssembly;
+            delegate* unmanaged<int, NativeParameter*, IntPtr> resolveConstructor
+                = &Unmanaged.ResolveConstructor;
+            delegate* unmanaged<IntPtr, byte, IntPtr> addObjectRef = &Unmanaged.AddObjectRef;
+            delegate* unmanaged<IntPtr, void> freeObjectRef = &Unmanaged.FreeObjectRef;
+            delegate* unmanaged<char*, int, void> freeTypeRef = &Unmanaged.FreeTypeRef;
+            delegate* unmanaged<GCInfo*, void> getGCInfo = &Unmanaged.GetGCInfo;
+
+            GCInfo gcInfo;
+            getGCInfo(&gcInfo);
+            if (gcInfo.TotalAvailableMemoryBytes <= 0)
+                return false;
+
+            const string assemblyName = "FooLib";
+            const string typeName = "FooLib.Foo, FooLib";
+            fixed (char* assemblyNamePtr = assemblyName, typeNamePtr = typeName) {
+                if (loadAssembly(assemblyNamePtr, assemblyName.Length) == 0)
+                    return false;
+
+                var ctorParam = new NativeParameter { TypeName = (IntPtr)typeNamePtr };
+                if (resolveConstructor(1, &ctorParam) == IntPtr.Zero)
+                    return false;
+
+                // Native parameter info is matched in place, regardless of the prepare mode
+                var ctorSignature = Signature.Get(1, &ctorParam);
+                var backgroundParam = new NativeParameter
+                {
+                    TypeName = ctorParam.TypeName,
+                    ParamInfo = new Parameter(typeName)
+                        .WithPrepareMode((int)PrepareMode.Background).ParamInfo
+                };
+                var voidParam = new NativeParameter();
+                if (ctorSignature != Signature.Get(new[] { new Parameter(typeName) }))
+                    return false;
+                if (Signature.Get(1, &backgroundParam) != ctorSignature)
+                    return false;
+                if (Signature.Get(1, &voidParam) == ctorSignature)
+                    return false;
+
+                var objRef = GetRefPtrToObject(new object());
+                var newObjRef = addObjectRef(objRef, 1);
+                if (newObjRef == IntPtr.Zero)
+                    return false;
+                freeObjectRef(newObjRef);
+                freeObjectRef(objRef);
+
+                // Invalid object ref.: exception must not be propagated
+                freeObjectRef(objRef);
+
+                freeTypeRef(typeNamePtr, typeName.Length);
+            }
+            return ObjectRefs.IsEmpty && DelegateRefs.IsEmpty;
+        }
+
+        private static bool TestBootstrap()
+        {
+            var tableSize = FunctionTableHeaderSize + FunctionTable.Length * IntPtr.Size;
+            var table = Marshal.AllocHGlobal(tableSize);
+            try {
+                if (Bootstrap(table, tableSize) != 0)
+                    return false;
+                if (Marshal.ReadInt32(table, 0) != FunctionTableVersion)
+                    return false;
+                if (Marshal.ReadInt32(table, sizeof(int)) != FunctionTable.Length)
+                    return false;
+                for (int i = 0; i < FunctionTable.Length; ++i) {
+                    var offset = FunctionTableHeaderSize + i * IntPtr.Size;
+                    if (Marshal.ReadIntPtr(table, offset) == IntPtr.Zero)
+                        return false;
+                }
+                // Smaller (e.g. older) tables only get the functions that fit
+                if (Bootstrap(table, FunctionTableHeaderSize + IntPtr.Size) != 0)
+                    return false;
+                return Marshal.ReadInt32(table, sizeof(int)) == 1;
+            } finally {
+                Marshal.FreeHGlobal(table);
+            }
+        }
+
         private static void TestNativeEventHandler(
                     IntPtr context,
                     string eventName,
@@ -0,0 +1,551 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    public partial class Adapter
+    {
+        /// <summary>
+        /// Blittable representation of a parameter info record, as passed by native code
+        /// (see QDotNetParameter).
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NativeParameter
+        {
+            public IntPtr TypeName;
+            public ulong ParamInfo;
+        }
+
+        /// <summary>
+        /// Blittable representation of a batch resolve request, as passed by native code
+        /// (see QDotNetAdapter::resolveMany()).
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NativeResolveRequest
+        {
+            public IntPtr MethodName;
+            public int MethodNameLength;
+            public int Kind;
+            public int SignatureId;
+            public int PrepareMode;
+        }
+
+        /// <summary>
+        /// Adapter public functions as [UnmanagedCallersOnly] entry points. These are called
+        /// from native code through plain function pointers, with no marshaling stub:
+        ///  - strings are passed as a pointer to UTF-16 data and a length;
+        ///  - parameter info is passed as a pointer to an array of NativeParameter;
+        ///  - boolean values are passed as bytes (0 = false);
+        ///  - object references are passed as IntPtr.
+        /// Exceptions are not propagated to native code; a zero value is returned instead.
+        /// </summary>
+        public static unsafe class Unmanaged
+        {
+            private static string GetString(char* str, int length)
+            {
+                return str == null ? null : new string(str, 0, length);
+            }
+
+            /// <summary>
+            /// Get a type or member name. Names already seen are found by comparing the native
+            /// string in place, so that resolving the same member again allocates no strings.
+            /// </summary>
+            private static string GetName(char* str, int length)
+            {
+                if (str == null)
+                    return null;
+                var name = new ReadOnlySpan<char>(str, length);
+                var slot = string.GetHashCode(name) & (Names.Length - 1);
+                if (Names[slot] is { } cached && name.SequenceEqual(cached))
+                    return cached;
+                return Names[slot] = new string(name);
+            }
+
+            private static string[] Names { get; } = new string[1024];
+
+            private static PrepareMode GetPrepareMode(
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                if (parameters == null || parameterCount == 0)
+                    return GlobalPrepareMode;
+                return Adapter.GetPrepareMode(
+                    new Parameter(string.Empty, parameters[0].ParamInfo).PrepareMode);
+            }
+
+            private static Parameter[] GetParameters(
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                if (parameters == null)
+                    return Array.Empty<Parameter>();
+                var managedParameters = new Parameter[parameterCount];
+                for (int i = 0; i < parameterCount; ++i) {
+                    managedParameters[i] = new Parameter(
+                        Marshal.PtrToStringUni(parameters[i].TypeName), parameters[i].ParamInfo);
+                }
+                return managedParameters;
+            }
+
+            [UnmanagedCallersOnly]
+            public static byte LoadAssembly(char* assemblyName, int assemblyNameLength)
+            {
+                try {
+                    var result = Adapter.LoadAssembly(GetString(assemblyName, assemblyNameLength));
+                    return result ? (byte)1 : (byte)0;
+                } catch (Exception) {
+                    return 0;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveStaticMethod(
+                char* typeName,
+                int typeNameLength,
+                char* methodName,
+                int methodNameLength,
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                try {
+                    return Adapter.ResolveStaticMethod(
+                        GetName(typeName, typeNameLength),
+                        GetName(methodName, methodNameLength),
+                        Signature.Get(parameterCount, parameters),
+                        GetPrepareMode(parameterCount, parameters));
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveConstructor(
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                try {
+                    if (parameters == null || parameterCount == 0)
+                        return IntPtr.Zero;
+                    return Adapter.ResolveConstructor(
+                        Signature.Get(parameterCount, parameters),
+                        GetPrepareMode(parameterCount, parameters));
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveInstanceMethod(
+                IntPtr objRefPtr,
+                char* methodName,
+                int methodNameLength,
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                try {
+                    return Adapter.ResolveInstanceMethod(
+                        objRefPtr,
+                        GetName(methodName, methodNameLength),
+                        Signature.Get(parameterCount, parameters),
+                        GetPrepareMode(parameterCount, parameters));
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveSafeMethod(
+                IntPtr funcPtr,
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                try {
+                    return Adapter.ResolveSafeMethod(
+                        funcPtr,
+                        parameterCount,
+                        GetParameters(parameterCount, parameters));
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void AddEventHandler(
+                IntPtr objRefPtr,
+                char* eventName,
+                int eventNameLength,
+                IntPtr context,
+                IntPtr eventHandler)
+            {
+                try {
+                    Adapter.AddEventHandler(
+                        objRefPtr,
+                        GetString(eventName, eventNameLength),
+                        context,
+                        Marshal.GetDelegateForFunctionPointer<Delegates.NativeEventHandler>(
+                            eventHandler));
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void RemoveEventHandler(
+                IntPtr objRefPtr,
+                char* eventName,
+                int eventNameLength,
+                IntPtr context)
+            {
+                try {
+                    Adapter.RemoveEventHandler(
+                        objRefPtr, GetString(eventName, eventNameLength), context);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void RemoveAllEventHandlers(IntPtr objRefPtr)
+            {
+                try {
+                    Adapter.RemoveAllEventHandlers(objRefPtr);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr AddObjectRef(IntPtr objRefPtr, byte weakRef)
+            {
+                try {
+                    return Adapter.AddObjectRef(objRefPtr, weakRef != 0);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void FreeDelegateRef(IntPtr delRefPtr)
+            {
+                try {
+                    Adapter.FreeDelegateRef(delRefPtr);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void FreeObjectRef(IntPtr objRefPtr)
+            {
+                try {
+                    Adapter.FreeObjectRef(objRefPtr);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void FreeTypeRef(char* typeName, int typeNameLength)
+            {
+                try {
+                    Adapter.FreeTypeRef(GetString(typeName, typeNameLength));
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr AddInterfaceProxy(char* interfaceName, int interfaceNameLength)
+            {
+                try {
+                    var proxy = Adapter.AddInterfaceProxy(
+                        GetString(interfaceName, interfaceNameLength));
+                    return proxy == null ? IntPtr.Zero : GetRefPtrToObject(proxy);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void SetInterfaceMethod(
+                IntPtr proxyRefPtr,
+                char* methodName,
+                int methodNameLength,
+                int parameterCount,
+                NativeParameter* parameters,
+                IntPtr callbackPtr,
+                IntPtr cleanUpPtr,
+                IntPtr context)
+            {
+                try {
+                    if (GetObjectRefFromPtr(proxyRefPtr)?.Target is not InterfaceProxy proxy)
+                        return;
+                    Adapter.SetInterfaceMethod(
+                        proxy,
+                        GetString(methodName, methodNameLength),
+                        parameterCount,
+                        GetParameters(parameterCount, parameters),
+                        callbackPtr,
+                        cleanUpPtr,
+                        context);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr GetObject(IntPtr objRefPtr, char* path, int pathLength)
+            {
+                try {
+                    return Adapter.GetObject(objRefPtr, GetString(path, pathLength));
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void GetGCInfo(GCInfo* info)
+            {
+                try {
+                    Adapter.GetGCInfo(out *info);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void StartProfile()
+            {
+                try {
+                    Adapter.StartProfile();
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static byte SaveProfile(char* path, int pathLength)
+            {
+                try {
+                    return Adapter.SaveProfile(GetString(path, pathLength)) ? (byte)1 : (byte)0;
+                } catch (Exception) {
+                    return 0;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static int ReplayProfile(char* path, int pathLength)
+            {
+                try {
+                    return Adapter.ReplayProfile(GetString(path, pathLength));
+                } catch (Exception) {
+                    return -1;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveOpenInstanceMethod(
+                char* typeName,
+                int typeNameLength,
+                char* methodName,
+                int methodNameLength,
+                int parameterCount,
+                NativeParameter* parameters)
+            {
+                try {
+                    return Adapter.ResolveOpenInstanceMethod(
+                        GetName(typeName, typeNameLength),
+                        GetName(methodName, methodNameLength),
+                        Signature.Get(parameterCount, parameters),
+                        GetPrepareMode(parameterCount, parameters));
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void SetPrepareMode(int mode)
+            {
+                try {
+                    Adapter.SetPrepareMode(mode);
+                } catch (Exception) {
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static int GetCounters(long* counters, int count)
+            {
+                try {
+                    return Adapter.GetCounters((IntPtr)counters, count);
+                } catch (Exception) {
+                    return 0;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static void SetRefFreedCallback(IntPtr callback)
+            {
+                try {
+                    Adapter.SetRefFreedCallback(callback);
+                } catch (Exception) {
+                }
+            }
+
+            /// <summary>
+            /// Copy the type name of an object to a native buffer. If the buffer is too small,
+            /// nothing is copied, and the caller may retry with a buffer of the returned size.
+            /// </summary>
+            /// <returns>Length of the type name, or -1 if not available</returns>
+            [UnmanagedCallersOnly]
+            public static int GetObjectTypeName(IntPtr objRefPtr, char* buffer, int bufferSize)
+            {
+                try {
+                    if (Adapter.GetObjectTypeName(objRefPtr) is not { } typeName)
+                        return -1;
+                    if (buffer != null && typeName.Length <= bufferSize)
+                        typeName.CopyTo(new Span<char>(buffer, bufferSize));
+                    return typeName.Length;
+                } catch (Exception) {
+                    return -1;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static int RegisterSignature(int parameterCount, NativeParameter* parameters)
+            {
+                try {
+                    return Adapter.RegisterSignature(
+                        parameterCount,
+                        GetParameters(parameterCount, parameters));
+                } catch (Exception) {
+                    return 0;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveStaticMethodById(
+                char* typeName,
+                int typeNameLength,
+                char* methodName,
+                int methodNameLength,
+                int signatureId,
+                int prepareMode)
+            {
+                try {
+                    return Adapter.ResolveStaticMethodById(
+                        GetName(typeName, typeNameLength),
+                        GetName(methodName, methodNameLength),
+                        signatureId,
+                        prepareMode);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveConstructorById(int signatureId, int prepareMode)
+            {
+                try {
+                    return Adapter.ResolveConstructorById(signatureId, prepareMode);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveInstanceMethodById(
+                IntPtr objRefPtr,
+                char* methodName,
+                int methodNameLength,
+                int signatureId,
+                int prepareMode)
+            {
+                try {
+                    return Adapter.ResolveInstanceMethodById(
+                        objRefPtr,
+                        GetName(methodName, methodNameLength),
+                        signatureId,
+                        prepareMode);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveOpenInstanceMethodById(
+                char* typeName,
+                int typeNameLength,
+                char* methodName,
+                int methodNameLength,
+                int signatureId,
+                int prepareMode)
+            {
+                try {
+                    return Adapter.ResolveOpenInstanceMethodById(
+                        GetName(typeName, typeNameLength),
+                        GetName(methodName, methodNameLength),
+                        signatureId,
+                        prepareMode);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static IntPtr ResolveSafeMethodById(
+                IntPtr funcPtr,
+                int signatureId,
+                int prepareMode)
+            {
+                try {
+                    return Adapter.ResolveSafeMethodById(funcPtr, signatureId, prepareMode);
+                } catch (Exception) {
+                    return IntPtr.Zero;
+                }
+            }
+
+            [UnmanagedCallersOnly]
+            public static int ResolveMany(
+                char* typeName,
+                int typeNameLength,
+                IntPtr objRefPtr,
+                int requestCount,
+                NativeResolveRequest* requests,
+                IntPtr* funcPtrs)
+            {
+                if (requests == null || funcPtrs == null || requestCount <= 0)
+                    return 0;
+                try {
+                    var managedRequests = new ResolveRequest[requestCount];
+                    for (int i = 0; i < requestCount; ++i) {
+                        managedRequests[i] = new ResolveRequest
+                        {
+                            MethodName = GetName(
+                                (char*)requests[i].MethodName, requests[i].MethodNameLength),
+                            Kind = requests[i].Kind,
+                            SignatureId = requests[i].SignatureId,
+                            PrepareMode = requests[i].PrepareMode
+                        };
+                    }
+                    var managedFuncPtrs = new IntPtr[requestCount];
+                    var resolved = Adapter.ResolveMany(
+                        GetName(typeName, typeNameLength),
+                        objRefPtr,
+                        requestCount,
+                        managedRequests,
+                        managedFuncPtrs);
+                    for (int i = 0; i < requestCount; ++i)
+                        funcPtrs[i] = managedFuncPtrs[i];
+                    return resolved;
+                } catch (Exception) {
+                    for (int i = 0; i < requestCount; ++i)
+                        funcPtrs[i] = IntPtr.Zero;
+                    return 0;
+                }
+            }
+
+#if DEBUG || TESTS
+            [UnmanagedCallersOnly]
+            public static void Stats(int* refCount, int* staticCount, int* eventCount)
+            {
+                Adapter.Stats(out *refCount, out *staticCount, out *eventCount);
+            }
+#endif
+        }
+    }
+}
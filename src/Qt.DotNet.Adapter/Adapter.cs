@@ -50,17 +50,29 @@ namespace Qt.DotNet
             return false;
         }
 
+        /// <summary>
+        /// Function pointer to a resolved method, either of a marshaling delegate (kept alive by
+        /// a GC handle) or of a generated trampoline (see CodeGenerator.CreateTrampoline()).
+        /// </summary>
         internal class DelegateRef
         {
             public GCHandle Handle { get; }
-            public bool IsValid => Handle.IsAllocated;
+            public bool IsValid => Handle.IsAllocated || IsTrampoline;
+            public bool IsTrampoline => !Handle.IsAllocated && Method != null;
             public Delegate Target => Handle.Target as Delegate;
             public IntPtr FuncPtr { get; }
+            public MethodBase Method => Handle.IsAllocated ? Target?.Method : method;
+            private readonly MethodBase method;
             public DelegateRef(GCHandle handle, IntPtr funcPtr)
             {
                 Handle = handle;
                 FuncPtr = funcPtr;
             }
+            public DelegateRef(MethodBase trampolineTarget, IntPtr funcPtr)
+            {
+                method = trampolineTarget;
+                FuncPtr = funcPtr;
+            }
         }
 
         internal class ObjectRef
@@ -68,16 +80,39 @@ namespace Qt.DotNet
             public GCHandle Handle { get; }
             public object Target => Handle.Target;
             public bool IsValid => Handle.IsAllocated && Handle.Target != null;
-            public ObjectRef(GCHandle handle)
+            public bool IsWeak { get; }
+            public ObjectRef(GCHandle handle, bool isWeak = false)
             {
                 Handle = handle;
+                IsWeak = isWeak;
             }
         }
 
+        /// <summary>
+        /// Strong object refs and delegates of a target object (see RefsByTarget). Access must
+        /// be synchronized by locking the instance; once removed from the index, an instance
+        /// is no longer updated.
+        /// </summary>
+        internal class TargetRefs
+        {
+            public HashSet<IntPtr> ObjectRefs { get; } = new();
+            public HashSet<IntPtr> Delegates { get; } = new();
+            public bool IsRemoved { get; set; }
+            public bool IsEmpty => ObjectRefs.Count == 0 && Delegates.Count == 0;
+        }
+
         private static ConcurrentDictionary
             <IntPtr, ObjectRef> ObjectRefs
         { get; } = new();
 
+        /// <summary>
+        /// Weak object refs, which are not in RefsByTarget, as the index would keep their
+        /// targets alive.
+        /// </summary>
+        private static ConcurrentDictionary
+            <IntPtr, ObjectRef> WeakObjectRefs
+        { get; } = new();
+
         private static ConcurrentDictionary
             <IntPtr, (object Target, MethodBase Method, DelegateRef Ref)> DelegateRefs
         { get; } = new();
@@ -86,6 +121,14 @@ namespace Qt.DotNet
             <(object Target, MethodBase Method), DelegateRef> DelegatesByMethod
         { get; } = new();
 
+        /// <summary>
+        /// Per-target index of object refs and delegates, so that releasing a ref does not need
+        /// to search all refs. Targets are compared as in DelegatesByMethod.
+        /// </summary>
+        private static ConcurrentDictionary
+            <object, TargetRefs> RefsByTarget
+        { get; } = new();
+
         private static ConcurrentDictionary
             <(ObjectRef Source, string Name, IntPtr Context), EventRelay> Events
         { get; } = new();
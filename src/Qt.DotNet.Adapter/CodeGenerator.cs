@@ -5,16 +5,15 @@
 
 using System.Collections.Concurrent;
 using System.Diagnostics;
-using System.Diagnostics.CodeAnalysis;
 using System.Reflection;
 using System.Reflection.Emit;
 using System.Runtime.InteropServices;
 
 namespace Qt.DotNet
 {
-    using DelegateIndex = ConcurrentDictionary<(MethodBase, Parameter[]), Type>;
-    using ProxyIndex = ConcurrentDictionary<(MethodBase, Parameter[]), MethodInfo>;
-    using IIndexer = IEqualityComparer<(MethodBase method, Parameter[] parameters)>;
+    using DelegateIndex = LruCache<(MethodBase, int), Type>;
+    using SharedDelegateIndex = LruCache<(int, string), Type>;
+    using ProxyIndex = LruCache<(MethodBase, int), MethodInfo>;
 
     public class SafeReturn<T>
     {
@@ -22,20 +21,41 @@ namespace Qt.DotNet
         public Exception Exception { get; init; }
     }
 
+    /// <summary>
+    /// Conversion of object references in generated trampolines (see
+    /// CodeGenerator.CreateTrampoline()), in place of ObjectMarshaler.
+    /// </summary>
+    public static class ObjectRefConverter
+    {
+        public static object ToObject(IntPtr objRefPtr) => ObjectMarshaler.ToManaged(objRefPtr);
+        public static IntPtr ToObjectRef(object obj) => ObjectMarshaler.ToNative(obj, false);
+        public static IntPtr ToWeakObjectRef(object obj) => ObjectMarshaler.ToNative(obj, true);
+    }
+
     /// <summary>
     /// Functions that generate code at run-time, needed to support native interop.
     /// </summary>
     internal static class CodeGenerator
     {
-        public static MethodInfo CreateSafeMethod(MethodInfo unsafeMethod)
+        /// <summary>
+        /// Generate a lightweight (collectible) method that calls a given method or constructor,
+        /// and returns either its result or the exception thrown, wrapped in a SafeReturn object.
+        /// </summary>
+        /// <remarks>
+        /// The safe method takes the target object as first argument (ignored for static methods
+        /// and constructors), followed by the arguments of the encapsulated method.
+        /// </remarks>
+        /// <param name="unsafeMethod">Method or constructor to call</param>
+        /// <returns>Generated method information</returns>
+        public static MethodInfo CreateSafeMethod(MethodBase unsafeMethod)
         {
 #if TESTS || DEBUG
             Debug.Assert(unsafeMethod.DeclaringType != null, "unsafeMethod.DeclaringType is null");
 #endif
-            var typeGen = ModuleGen.DefineType(
-                UniqueName("Safe", unsafeMethod.DeclaringType?.Name, unsafeMethod.Name),
-                TypeAttributes.Public, typeof(object));
-            var returnType = unsafeMethod.ReturnType;
+            var ctor = unsafeMethod as ConstructorInfo;
+            var returnType = ctor != null
+                ? ctor.DeclaringType
+                : ((MethodInfo)unsafeMethod).ReturnType;
             var returnTypeIsVoid = returnType == typeof(void);
             var paramTypes = unsafeMethod.GetParameters()
                 .Select(x => x.ParameterType)
@@ -55,9 +75,10 @@ namespace Qt.DotNet
             Debug.Assert(safeReturnSetException != null,
                 nameof(safeReturnSetException) + " is null");
 #endif
-            var safeMethod = typeGen.DefineMethod("SafeInvoke",
-                MethodAttributes.Public | MethodAttributes.HideBySig | MethodAttributes.Static,
+            var safeMethod = new DynamicMethod(
+                UniqueName("Safe", unsafeMethod.DeclaringType?.Name, MethodName(unsafeMethod)),
                 safeReturnType, paramTypes);
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedMethods);
             var code = safeMethod.GetILGenerator();
 
             code.DeclareLocal(safeReturnType);
@@ -72,25 +93,20 @@ namespace Qt.DotNet
             code.BeginExceptionBlock();
             {
                 // this = arg0
-                if (!unsafeMethod.IsStatic)
+                if (ctor == null && !unsafeMethod.IsStatic)
                     code.Emit(OpCodes.Ldarg_0);
 
                 // Load arguments into stack
-                for (int paramIdx = 1; paramIdx < paramTypes.Length; ++paramIdx) {
-                    if (paramIdx == 1)
-                        code.Emit(OpCodes.Ldarg_1);
-                    else if (paramIdx == 2)
-                        code.Emit(OpCodes.Ldarg_2);
-                    else if (paramIdx == 3)
-                        code.Emit(OpCodes.Ldarg_3);
-                    else
-                        code.Emit(OpCodes.Ldarg_S, paramIdx + 1);
-                }
+                for (int paramIdx = 1; paramIdx < paramTypes.Length; ++paramIdx)
+                    EmitLoadArg(code, paramIdx);
 
                 // Invoke method
                 if (!returnTypeIsVoid) {
                     // {1} = unsafeMethod([...]);
-                    code.Emit(OpCodes.Call, unsafeMethod);
+                    if (ctor != null)
+                        code.Emit(OpCodes.Newobj, ctor);
+                    else
+                        code.Emit(OpCodes.Call, (MethodInfo)unsafeMethod);
                     code.Emit(OpCodes.Stloc_1);
                     // {0}.Value = {1};
                     code.Emit(OpCodes.Ldloc_0);
@@ -98,7 +114,7 @@ namespace Qt.DotNet
                     code.Emit(OpCodes.Call, safeReturnSetValue);
                 } else {
                     // unsafeMethod([...]);
-                    code.Emit(OpCodes.Call, unsafeMethod);
+                    code.Emit(OpCodes.Call, (MethodInfo)unsafeMethod);
                 }
             }
             // ... } catch (Exception [0]) { ...
@@ -117,10 +133,7 @@ namespace Qt.DotNet
             code.Emit(OpCodes.Ldloc_0);
             code.Emit(OpCodes.Ret);
 
-            var safeInvokeType = typeGen.CreateType()
-                ?? throw new TypeAccessException("Error creating safe invoke");
-            var safeInvoke = safeInvokeType.GetMethod("SafeInvoke");
-            return safeInvoke;
+            return safeMethod;
         }
 
         public static Type CreateInterfaceProxyType(Type interfaceType)
@@ -194,16 +207,8 @@ namespace Qt.DotNet
                 code.Emit(OpCodes.Ldarg_0);
                 code.Emit(OpCodes.Ldfld, countGen);
                 // Load method call arguments into stack
-                for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx) {
-                    if (paramIdx == 0)
-                        code.Emit(OpCodes.Ldarg_1);
-                    else if (paramIdx == 1)
-                        code.Emit(OpCodes.Ldarg_2);
-                    else if (paramIdx == 2)
-                        code.Emit(OpCodes.Ldarg_3);
-                    else
-                        code.Emit(OpCodes.Ldarg_S, paramIdx + 1);
-                }
+                for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx)
+                    EmitLoadArg(code, paramIdx + 1);
                 //  ); //NativeCallback.Invoke
                 code.Emit(OpCodes.Callvirt, callbackInvoke);
 
@@ -226,14 +231,30 @@ namespace Qt.DotNet
 
                 // Generate nested type
                 delegateGen.CreateType();
+                Adapter.IncrementCounter(Adapter.Counter.GeneratedTypes);
             }
             proxyType = typeGen.CreateType();
-            InterfaceProxyTypes.TryAdd(interfaceType, proxyType);
-            return proxyType;
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedTypes);
+            return InterfaceProxyTypes.GetOrAdd(interfaceType, proxyType);
         }
 
+        /// <summary>
+        /// Generate a delegate type that matches a signature, e.g. of a native callback.
+        /// </summary>
+        /// <remarks>
+        /// Delegate types are shared by all callers with the same signature.
+        /// </remarks>
+        /// <param name="methodName">Name of the method, used in the name of the type</param>
+        /// <param name="parameters">Marshaling configuration of each parameter</param>
+        /// <returns>Generated delegate type</returns>
+        /// <exception cref="TypeAccessException"/>
         public static Type CreateDelegateType(string methodName, Parameter[] parameters)
         {
+            // Check if already in cache
+            var key = (Signature.Get(parameters).Id, string.Empty);
+            if (SharedDelegateTypes.TryGetValue(key, out Type cachedType))
+                return cachedType;
+
             // Generate dynamic Delegate sub-type
             var typeGen = ModuleGen.DefineType(
                 UniqueName(methodName, "Delegate"),
@@ -245,38 +266,51 @@ namespace Qt.DotNet
             // Get generated type
             var delegateType = typeGen.CreateType()
                 ?? throw new TypeAccessException("Error creating dynamic delegate type");
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedTypes);
 
-            return delegateType;
+            return SharedDelegateTypes.GetOrAdd(key, delegateType);
         }
 
         /// <summary>
         /// Generate a delegate type that matches the signature of a given method.
         /// </summary>
         /// <remarks>
-        /// This is used to configure marshaling for incoming native interop calls.
+        /// This is used to configure marshaling for incoming native interop calls. Lightweight
+        /// methods (e.g. proxy methods) share delegate types by signature and parameter types,
+        /// so that the delegate type outlives a method that is reclaimed, and is reused if the
+        /// method is generated again.
         /// </remarks>
         /// <param name="method">Information on the managed method being called</param>
-        /// <param name="parameters">Marshaling configuration of each parameter</param>
+        /// <param name="signature">Marshaling configuration of each parameter</param>
         /// <returns>Generated delegate type</returns>
         /// <exception cref="TypeAccessException"/>
-        public static Type CreateDelegateTypeForMethod(MethodInfo method, Parameter[] parameters)
+        public static Type CreateDelegateTypeForMethod(MethodInfo method, Signature signature)
         {
+            var parameters = signature.Parameters;
 #if TESTS || DEBUG
             Debug.Assert(method.GetParameters().Length == parameters.Length - 1);
-            Debug.Assert(method.DeclaringType != null, "method.DeclaringType is null");
-            Debug.Assert(method.ReturnType.IsAssignableTo(parameters[0].GetParameterType())
-                || method.ReturnType.IsAssignableFrom(parameters[0].GetParameterType()));
+            Debug.Assert(method.ReturnType.IsAssignableTo(signature.GetParameterType(0))
+                || method.ReturnType.IsAssignableFrom(signature.GetParameterType(0)));
             Debug.Assert(method.GetParameters().Zip(parameters.Skip(1))
                 .All(x => x.First.ParameterType.IsAssignableTo(x.Second.GetParameterType())
                     || x.First.ParameterType.IsAssignableFrom(x.Second.GetParameterType())));
 #endif
             // Check if already in cache
-            if (DelegateTypes.TryGetValue((method, parameters), out Type delegateType))
-                return delegateType;
+            var isLightweight = method is DynamicMethod;
+            var sharedKey = isLightweight ? (signature.Id, TypeListKey(method)) : default;
+            if (isLightweight) {
+                if (SharedDelegateTypes.TryGetValue(sharedKey, out Type sharedType))
+                    return sharedType;
+            } else if (DelegateTypes.TryGetValue((method, signature.Id), out Type cachedType)) {
+                return cachedType;
+            } else if (InteropCache.GetDelegateType(method, signature) is { } savedType) {
+                // Generated in a previous run
+                return DelegateTypes.GetOrAdd((method, signature.Id), savedType);
+            }
 
             // Generate dynamic Delegate sub-type
             var typeGen = ModuleGen.DefineType(
-                UniqueName(method.DeclaringType.Name, method.Name),
+                UniqueName(method.DeclaringType?.Name ?? "Dynamic", method.Name),
                 TypeAttributes.Sealed | TypeAttributes.Public,
                 typeof(MulticastDelegate));
 
@@ -322,72 +356,289 @@ namespace Qt.DotNet
             }
 
             // Get generated type
-            delegateType = typeGen.CreateType()
+            var delegateType = typeGen.CreateType()
                 ?? throw new TypeAccessException("Error creating dynamic delegate type");
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedTypes);
 
             // Add to cache and return
-            DelegateTypes.TryAdd((method, parameters), delegateType);
-            return delegateType;
+            if (isLightweight)
+                return SharedDelegateTypes.GetOrAdd(sharedKey, delegateType);
+            InteropCache.Add(InteropCache.EntryKind.Delegate, method, signature);
+            return DelegateTypes.GetOrAdd((method, signature.Id), delegateType);
         }
 
         /// <summary>
-        /// Generate static method that encapsulates a call to a given constructor.
+        /// Generate an [UnmanagedCallersOnly] trampoline that calls a given static method,
+        /// constructor or instance method, if all parameters in the signature are blittable
+        /// primitives or object references.
+        /// Object references are passed as raw handles and converted in the generated code, so
+        /// that calls through the trampoline do not go through an interop marshaling stub.
         /// </summary>
         /// <remarks>
-        /// This is used to configure marshaling for incoming native interop calls to constructors.
+        /// Trampolines are shared by all resolves of the same method and signature. Trampolines
+        /// of instance methods take the target object as the first argument (i.e. open-instance
+        /// calls).
         /// </remarks>
-        /// <param name="ctor">Constructor information</param>
+        /// <param name="method">Static method, constructor or instance method to call</param>
+        /// <param name="signature">Marshaling configuration of each parameter</param>
+        /// <returns>Function pointer of the trampoline; zero if the signature is not
+        /// supported</returns>
+        /// <exception cref="TypeAccessException"></exception>
+        public static IntPtr CreateTrampoline(MethodBase method, Signature signature)
+        {
+            // Check if already in cache (including unsupported signatures)
+            if (Trampolines.TryGetValue((method, signature.Id), out IntPtr trampoline))
+                return trampoline;
+            // Check if generated in a previous run; trampolines of constructors and instance
+            // methods are saved with the proxy method
+            if (!method.IsStatic || method is ConstructorInfo) {
+                if (GetCachedProxy(method, signature) is { } cachedProxy
+                    && Trampolines.TryGetValue((cachedProxy, signature.Id), out trampoline)) {
+                    return Trampolines.GetOrAdd((method, signature.Id), trampoline);
+                }
+            } else if (InteropCache.GetTrampoline((MethodInfo)method, signature)
+                is { } cachedTrampoline) {
+                return Trampolines.GetOrAdd((method, signature.Id),
+                    cachedTrampoline.MethodHandle.GetFunctionPointer());
+            }
+            if (!CanCreateTrampoline(method, signature)) {
+                Trampolines.TryAdd((method, signature.Id), IntPtr.Zero);
+                return IntPtr.Zero;
+            }
+
+            // Trampoline takes object references as handles, and primitives as they are
+            var ctor = method as ConstructorInfo;
+            var instanceMethod = ctor == null && !method.IsStatic ? (MethodInfo)method : null;
+            var targetType = method.DeclaringType;
+            var returnType = ctor != null ? targetType : ((MethodInfo)method).ReturnType;
+            var paramTypes = method.GetParameters()
+                .Select(p => p.ParameterType)
+                .ToArray();
+            if (instanceMethod != null)
+                paramTypes = paramTypes.Prepend(targetType).ToArray();
+            var nativeParamTypes = paramTypes
+                .Select((type, i) => signature.Parameters[i + 1].MarshalAs == Parameter.ObjectRef
+                    ? typeof(IntPtr) : type)
+                .ToArray();
+            var returnParam = signature.Parameters[0];
+            var returnsObjectRef = returnType != typeof(void)
+                && returnParam.MarshalAs == Parameter.ObjectRef;
+            var nativeReturnType = returnsObjectRef ? typeof(IntPtr) : returnType;
+
+            // Generate placeholder type for trampoline
+            var typeGen = ModuleGen.DefineType(
+                UniqueName(targetType?.Name ?? "Static", MethodName(method), "Trampoline"),
+                TypeAttributes.Sealed | TypeAttributes.Public,
+                typeof(object));
+
+            // Generate trampoline method Invoke()
+            var trampolineGen = typeGen.DefineMethod("Invoke",
+                MethodAttributes.Public | MethodAttributes.HideBySig | MethodAttributes.Static,
+                nativeReturnType, nativeParamTypes);
+            trampolineGen.SetCustomAttribute(new CustomAttributeBuilder(
+                typeof(UnmanagedCallersOnlyAttribute).GetConstructor(Type.EmptyTypes),
+                Array.Empty<object>()));
+
+            // Get code generator for trampoline
+            var code = trampolineGen.GetILGenerator();
+
+            // Load arguments into stack, converting handles to objects
+            for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx) {
+                EmitLoadArg(code, paramIdx);
+                if (nativeParamTypes[paramIdx] == paramTypes[paramIdx])
+                    continue;
+                code.Emit(OpCodes.Call, ObjectRefToObject);
+                // this = ({targetType})arg0
+                if (instanceMethod != null && paramIdx == 0 && targetType.IsValueType)
+                    code.Emit(OpCodes.Unbox, targetType);
+                else if (paramTypes[paramIdx].IsValueType)
+                    code.Emit(OpCodes.Unbox_Any, paramTypes[paramIdx]);
+                else if (paramTypes[paramIdx] != typeof(object))
+                    code.Emit(OpCodes.Castclass, paramTypes[paramIdx]);
+            }
+
+            // Invoke encapsulated method or constructor
+            if (ctor != null)
+                code.Emit(OpCodes.Newobj, ctor);
+            else if (instanceMethod != null && !targetType.IsValueType)
+                code.Emit(OpCodes.Callvirt, instanceMethod);
+            else
+                code.Emit(OpCodes.Call, (MethodInfo)method);
+
+            // Return method result (if any), converting objects to handles
+            if (returnsObjectRef) {
+                if (returnType.IsValueType)
+                    code.Emit(OpCodes.Box, returnType);
+                code.Emit(OpCodes.Call,
+                    returnParam.IsWeakRef ? ObjectToWeakObjectRef : ObjectToObjectRef);
+            }
+            code.Emit(OpCodes.Ret);
+
+            // Get generated type
+            var trampolineType = typeGen.CreateType()
+                ?? throw new TypeAccessException("Error creating trampoline");
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedTypes);
+
+            // Get native entry point of the generated method
+            trampoline = trampolineType.GetMethod("Invoke").MethodHandle.GetFunctionPointer();
+
+            // Add to cache and return
+            InteropCache.Add(method.IsStatic && ctor == null
+                ? InteropCache.EntryKind.Trampoline
+                : InteropCache.EntryKind.Proxy, method, signature);
+            return Trampolines.GetOrAdd((method, signature.Id), trampoline);
+        }
+
+        /// <summary>
+        /// Check if a trampoline can be generated for a method, i.e. if the method is accessible
+        /// and each parameter, including the target object of instance methods, is either an
+        /// object reference or a primitive of the same type on both the managed and the native
+        /// side.
+        /// </summary>
+        private static bool CanCreateTrampoline(MethodBase method, Signature signature)
+        {
+            if (method.ContainsGenericParameters)
+                return false;
+            // The generated code must be able to access the method
+            if (!method.IsPublic || method.DeclaringType is not { IsVisible: true } declaringType)
+                return false;
+            var paramTypes = method.GetParameters()
+                .Select(p => p.ParameterType);
+            Type returnType;
+            if (method is ConstructorInfo) {
+                if (method.IsStatic || declaringType.IsAbstract)
+                    return false;
+                returnType = declaringType;
+            } else {
+                returnType = ((MethodInfo)method).ReturnType;
+                if (!method.IsStatic) {
+                    // Target object must be passed as an object reference
+                    if (signature.Length < 2
+                        || signature.Parameters[1].MarshalAs != Parameter.ObjectRef) {
+                        return false;
+                    }
+                    paramTypes = paramTypes.Prepend(declaringType);
+                }
+            }
+            return IsBlittableSignature(returnType, paramTypes.ToArray(), signature.Parameters);
+        }
+
+        /// <summary>
+        /// Check if each parameter is either an object reference or a primitive of the same type
+        /// on both the managed and the native side.
+        /// </summary>
+        /// <param name="returnType">Managed return type</param>
+        /// <param name="paramTypes">Managed parameter types</param>
         /// <param name="parameters">Marshaling configuration of each parameter</param>
+        internal static bool IsBlittableSignature(
+            Type returnType,
+            Type[] paramTypes,
+            Parameter[] parameters)
+        {
+            if (paramTypes.Length != parameters.Length - 1)
+                return false;
+
+            static bool IsBlittable(Type type, Parameter parameter)
+            {
+                if (type.IsByRef || type.IsPointer || parameter.IsArray)
+                    return false;
+                if (parameter.MarshalAs == Parameter.ObjectRef)
+                    return true;
+                if (type.IsEnum)
+                    type = Enum.GetUnderlyingType(type);
+                if (parameter.MarshalAs == 0)
+                    return BlittableTypes.ContainsValue(type);
+                return BlittableTypes.TryGetValue(parameter.MarshalAs, out var nativeType)
+                    && type == nativeType;
+            }
+
+            var returnParam = parameters[0];
+            if (returnType == typeof(void)) {
+                if (!returnParam.IsVoid)
+                    return false;
+            } else if (!IsBlittable(returnType, returnParam)) {
+                return false;
+            }
+            for (int i = 0; i < paramTypes.Length; ++i) {
+                if (!IsBlittable(paramTypes[i], parameters[i + 1]))
+                    return false;
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Primitive types passed as they are by native code, by marshaling type.
+        /// </summary>
+        private static Dictionary<UnmanagedType, Type> BlittableTypes { get; } = new()
+        {
+            { UnmanagedType.I1, typeof(sbyte) },
+            { UnmanagedType.U1, typeof(byte) },
+            { UnmanagedType.I2, typeof(short) },
+            { UnmanagedType.U2, typeof(ushort) },
+            { UnmanagedType.I4, typeof(int) },
+            { UnmanagedType.U4, typeof(uint) },
+            { UnmanagedType.I8, typeof(long) },
+            { UnmanagedType.U8, typeof(ulong) },
+            { UnmanagedType.R4, typeof(float) },
+            { UnmanagedType.R8, typeof(double) },
+            { UnmanagedType.SysInt, typeof(IntPtr) },
+            { UnmanagedType.SysUInt, typeof(UIntPtr) },
+        };
+
+        internal static MethodInfo ObjectRefToObject { get; }
+            = typeof(ObjectRefConverter).GetMethod(nameof(ObjectRefConverter.ToObject));
+        internal static MethodInfo ObjectToObjectRef { get; }
+            = typeof(ObjectRefConverter).GetMethod(nameof(ObjectRefConverter.ToObjectRef));
+        internal static MethodInfo ObjectToWeakObjectRef { get; }
+            = typeof(ObjectRefConverter).GetMethod(nameof(ObjectRefConverter.ToWeakObjectRef));
+
+        /// <summary>
+        /// Generate a lightweight (collectible) static method that encapsulates a call to a
+        /// given constructor.
+        /// </summary>
+        /// <remarks>
+        /// This is used to configure marshaling for incoming native interop calls to constructors
+        /// whose signature does not allow a trampoline (see CreateTrampoline()).
+        /// </remarks>
+        /// <param name="ctor">Constructor information</param>
+        /// <param name="signature">Marshaling configuration of each parameter</param>
         /// <returns>Generated method information</returns>
-        /// <exception cref="TypeAccessException"></exception>
         public static MethodInfo CreateProxyMethodForCtor(
-            ConstructorInfo ctor, Parameter[] parameters)
+            ConstructorInfo ctor, Signature signature)
         {
+            var parameters = signature.Parameters;
 #if TESTS || DEBUG
             Debug.Assert(ctor.GetParameters().Length == parameters.Length - 1);
             Debug.Assert(ctor.DeclaringType != null, "ctor.DeclaringType is null");
-            Debug.Assert(ctor.DeclaringType.IsAssignableTo(parameters[0].GetParameterType()));
+            Debug.Assert(ctor.DeclaringType.IsAssignableTo(signature.GetParameterType(0)));
             Debug.Assert(ctor.GetParameters().Zip(parameters.Skip(1))
                 .All(x => x.First.ParameterType.IsAssignableTo(x.Second.GetParameterType())));
 #endif
             // Check if already in cache
-            if (Proxies.TryGetValue((ctor, parameters), out MethodInfo proxy))
+            if (Proxies.TryGetValue((ctor, signature.Id), out MethodInfo proxy))
                 return proxy;
 
+            // Check if generated in a previous run
+            if (GetCachedProxy(ctor, signature) is { } cachedProxy)
+                return cachedProxy;
+
             // Proxy matches return and param types
             Type returnType = ctor.DeclaringType;
-            var paramInfos = ctor.GetParameters();
-            var paramTypes = paramInfos
+            var paramTypes = ctor.GetParameters()
                 .Select(p => p.ParameterType)
                 .ToArray();
 
-            // Generate placeholder type for proxy method
-            var typeGen = ModuleGen.DefineType(
-                UniqueName(returnType.Name, "ctor"),
-                TypeAttributes.Sealed | TypeAttributes.Public,
-                typeof(object));
-
-            // Generate proxy method Create()
-            var proxyGen = typeGen.DefineMethod("Create",
-                MethodAttributes.Public | MethodAttributes.HideBySig | MethodAttributes.Static,
-                returnType, paramTypes);
+            // Generate proxy method
+            var proxyGen = new DynamicMethod(
+                UniqueName(returnType.Name, "ctor"), returnType, paramTypes);
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedMethods);
 
             // Get code generator for proxy method
             var code = proxyGen.GetILGenerator();
 
             // Load arguments into stack
-            for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx) {
-                if (paramIdx == 0)
-                    code.Emit(OpCodes.Ldarg_0);
-                else if (paramIdx == 1)
-                    code.Emit(OpCodes.Ldarg_1);
-                else if (paramIdx == 2)
-                    code.Emit(OpCodes.Ldarg_2);
-                else if (paramIdx == 3)
-                    code.Emit(OpCodes.Ldarg_3);
-                else
-                    code.Emit(OpCodes.Ldarg_S, paramIdx);
-            }
+            for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx)
+                EmitLoadArg(code, paramIdx);
 
             // Invoke encapsulated constructor
             code.Emit(OpCodes.Newobj, ctor);
@@ -395,16 +646,128 @@ namespace Qt.DotNet
             // Return newly created object
             code.Emit(OpCodes.Ret);
 
-            // Get generated type
-            var proxyType = typeGen.CreateType()
-                ?? throw new TypeAccessException("Error creating dynamic ctor proxy");
+            // Add to cache and return
+            InteropCache.Add(InteropCache.EntryKind.Proxy, ctor, signature);
+            return Proxies.GetOrAdd((ctor, signature.Id), proxyGen);
+        }
 
-            // Get generated method
-            proxy = proxyType.GetMethod("Create");
+        /// <summary>
+        /// Generate a lightweight (collectible) static method that encapsulates a call to a
+        /// given instance method, with the target object passed as the first argument.
+        /// </summary>
+        /// <remarks>
+        /// This is used to create open-instance delegates, i.e. delegates that are shared by
+        /// all objects of a type, for methods whose signature does not allow a trampoline (see
+        /// CreateTrampoline()).
+        /// </remarks>
+        /// <param name="method">Instance method information</param>
+        /// <param name="signature">Marshaling configuration of each parameter, including the
+        /// target object (second element)</param>
+        /// <returns>Generated method information</returns>
+        public static MethodInfo CreateProxyMethodForInstanceMethod(
+            MethodInfo method, Signature signature)
+        {
+            var parameters = signature.Parameters;
+#if TESTS || DEBUG
+            Debug.Assert(!method.IsStatic, "method is static");
+            Debug.Assert(method.GetParameters().Length == parameters.Length - 2);
+            Debug.Assert(method.DeclaringType != null, "method.DeclaringType is null");
+#endif
+            // Check if already in cache
+            if (Proxies.TryGetValue((method, signature.Id), out MethodInfo proxy))
+                return proxy;
+
+            // Check if generated in a previous run
+            if (GetCachedProxy(method, signature) is { } cachedProxy)
+                return cachedProxy;
+
+            // Proxy takes the target object, followed by the method's param types
+            var targetType = method.DeclaringType;
+            var paramTypes = method.GetParameters()
+                .Select(p => p.ParameterType)
+                .Prepend(typeof(object))
+                .ToArray();
+
+            // Generate proxy method
+            var proxyGen = new DynamicMethod(
+                UniqueName(targetType.Name, method.Name), method.ReturnType, paramTypes);
+            Adapter.IncrementCounter(Adapter.Counter.GeneratedMethods);
+
+            // Get code generator for proxy method
+            var code = proxyGen.GetILGenerator();
+
+            // this = ({targetType})arg0
+            code.Emit(OpCodes.Ldarg_0);
+            if (targetType.IsValueType)
+                code.Emit(OpCodes.Unbox, targetType);
+            else
+                code.Emit(OpCodes.Castclass, targetType);
+
+            // Load remaining arguments into stack
+            for (int paramIdx = 1; paramIdx < paramTypes.Length; ++paramIdx)
+                EmitLoadArg(code, paramIdx);
+
+            // Invoke encapsulated method
+            code.Emit(targetType.IsValueType ? OpCodes.Call : OpCodes.Callvirt, method);
+
+            // Return method result (if any)
+            code.Emit(OpCodes.Ret);
 
             // Add to cache and return
-            Proxies.TryAdd((ctor, parameters), proxy);
-            return proxy;
+            InteropCache.Add(InteropCache.EntryKind.Proxy, method, signature);
+            return Proxies.GetOrAdd((method, signature.Id), proxyGen);
+        }
+
+        /// <summary>
+        /// Get a proxy method generated in a previous run (see InteropCache). The delegate type
+        /// and trampoline (if any) generated with the proxy method are also added to the caches.
+        /// </summary>
+        /// <returns>Proxy method, or null if not found</returns>
+        private static MethodInfo GetCachedProxy(MethodBase target, Signature signature)
+        {
+            var proxy = InteropCache.GetProxyMethod(
+                target, signature, out var delegateType, out var trampoline);
+            if (proxy == null)
+                return null;
+            DelegateTypes.TryAdd((proxy, signature.Id), delegateType);
+            Trampolines.TryAdd((proxy, signature.Id),
+                trampoline?.MethodHandle.GetFunctionPointer() ?? IntPtr.Zero);
+            return Proxies.GetOrAdd((target, signature.Id), proxy);
+        }
+
+        /// <summary>
+        /// Emit the shortest form of the instruction that loads a given argument into the stack.
+        /// </summary>
+        private static void EmitLoadArg(ILGenerator code, int argIdx)
+        {
+            switch (argIdx) {
+            case 0:
+                code.Emit(OpCodes.Ldarg_0);
+                break;
+            case 1:
+                code.Emit(OpCodes.Ldarg_1);
+                break;
+            case 2:
+                code.Emit(OpCodes.Ldarg_2);
+                break;
+            case 3:
+                code.Emit(OpCodes.Ldarg_3);
+                break;
+            case <= byte.MaxValue:
+                code.Emit(OpCodes.Ldarg_S, (byte)argIdx);
+                break;
+            default:
+                code.Emit(OpCodes.Ldarg, (short)argIdx);
+                break;
+            }
+        }
+
+        /// <summary>
+        /// Name of a method for use in generated names ("ctor" for constructors).
+        /// </summary>
+        private static string MethodName(MethodBase method)
+        {
+            return method is ConstructorInfo ? "ctor" : method.Name;
         }
 
         private static MethodBuilder InitDelegateType(TypeBuilder typeGen, Parameter[] parameters)
@@ -495,7 +858,7 @@ namespace Qt.DotNet
                     },
                     new object[]
                     {
-                        Type.GetType(parameter.TypeName),
+                        TypeCache.GetType(parameter.TypeName),
                         parameter.TypeName
                     });
             } else if (parameter.MarshalAs != 0) {
@@ -585,46 +948,98 @@ namespace Qt.DotNet
             = AssemblyGen.DefineDynamicModule(UniqueAssemblyName);
 
         /// <summary>
-        /// Delegate type cache.
+        /// Maximum number of entries of each generated code cache.
+        /// </summary>
+        internal const int CacheCapacity = 4096;
+
+        /// <summary>
+        /// Delegate type cache, by method and signature ID.
         /// </summary>
-        private static DelegateIndex DelegateTypes { get; } = new(new Indexer());
+        private static DelegateIndex DelegateTypes { get; } = new(CacheCapacity, Evicted);
 
         /// <summary>
-        /// Proxy method cache.
+        /// Delegate types shared by lightweight methods and native callbacks, by signature ID
+        /// and parameter types (see TypeListKey()).
         /// </summary>
-        private static ProxyIndex Proxies { get; } = new(new Indexer());
+        private static SharedDelegateIndex SharedDelegateTypes { get; }
+            = new(CacheCapacity, Evicted);
+
+        /// <summary>
+        /// Proxy method cache, by method and signature ID.
+        /// </summary>
+        private static ProxyIndex Proxies { get; } = new(CacheCapacity, Evicted);
+
+        /// <summary>
+        /// Trampoline cache, by method and signature ID; zero for unsupported signatures.
+        /// </summary>
+        /// <remarks>
+        /// Not bounded: function pointers of trampolines are kept by native code, and a
+        /// trampoline generated again would be a new type.
+        /// </remarks>
+        private static ConcurrentDictionary<(MethodBase, int), IntPtr> Trampolines { get; }
+            = new();
 
         /// <summary>
         /// Interface proxy type cache.
         /// </summary>
-        private static ConcurrentDictionary<Type, Type> InterfaceProxyTypes { get; } = new();
+        private static LruCache<Type, Type> InterfaceProxyTypes { get; }
+            = new(CacheCapacity, Evicted);
 
         /// <summary>
-        /// Cache custom indexer.
+        /// Number of entries in the generated code caches.
         /// </summary>
-        private class Indexer : IIndexer
+        public static int CachedCount => DelegateTypes.Count + SharedDelegateTypes.Count
+            + Proxies.Count + Trampolines.Count + InterfaceProxyTypes.Count;
+
+        private static void Evicted<TKey, TValue>(TKey key, TValue value)
         {
-            public bool Equals(
-                (MethodBase method, Parameter[] parameters) x,
-                (MethodBase method, Parameter[] parameters) y)
-            {
-                if (x.method != y.method)
-                    return false;
-                if (x.parameters.Length != y.parameters.Length)
-                    return false;
-                var xyParameters = x.parameters.Zip(y.parameters).ToList();
-                if (xyParameters.Any(xy => xy.First.ParamInfo != xy.Second.ParamInfo))
-                    return false;
-                return xyParameters.All(xy => xy.First.TypeName == xy.Second.TypeName);
-            }
+            Adapter.IncrementCounter(Adapter.Counter.EvictedGeneratedCode);
+        }
 
-            public int GetHashCode([DisallowNull] (MethodBase method, Parameter[] parameters) obj)
-            {
-                int hashCode = obj.method.GetHashCode();
-                foreach (var parameter in obj.parameters)
-                    hashCode = HashCode.Combine(hashCode, parameter.GetHashCode());
-                return hashCode;
+        /// <summary>
+        /// Drop generated code for a type that native code no longer references (see
+        /// Adapter.FreeTypeRef()).
+        /// </summary>
+        /// <remarks>
+        /// Proxy methods are lightweight methods, and are reclaimed once dropped. Safe wrappers,
+        /// also lightweight methods, are kept by the adapter, which releases them along with
+        /// the type (see Adapter.FreeSafeMethods()). Generated types cannot be unloaded, since
+        /// delegate marshaling and [UnmanagedCallersOnly] are not supported in collectible
+        /// assemblies; types generated for a type of a collectible assembly are also dropped,
+        /// so that the caches do not keep that assembly alive, while types generated for other
+        /// types are kept, to be reused if the type is used again.
+        /// </remarks>
+        /// <param name="type">Type being released</param>
+        /// <returns>Number of cache entries dropped</returns>
+        public static int Release(Type type)
+        {
+            bool IsMember(MethodBase method)
+                => method.DeclaringType == type || method.ReflectedType == type;
+
+            var count = Proxies.RemoveWhere((key, _) => IsMember(key.Item1));
+            if (!type.Assembly.IsCollectible)
+                return count;
+
+            count += DelegateTypes.RemoveWhere((key, _) => IsMember(key.Item1));
+            count += InterfaceProxyTypes.RemoveWhere((key, _) => key == type);
+            foreach (var key in Trampolines.Keys.Where(x => IsMember(x.Item1))) {
+                if (Trampolines.TryRemove(key, out _)) {
+                    Evicted(key, IntPtr.Zero);
+                    ++count;
+                }
             }
+            return count;
+        }
+
+        /// <summary>
+        /// Key of the return and parameter types of a method.
+        /// </summary>
+        private static string TypeListKey(MethodInfo method)
+        {
+            return string.Join(",", method.GetParameters()
+                .Select(p => p.ParameterType)
+                .Prepend(method.ReturnType)
+                .Select(t => t.AssemblyQualifiedName));
         }
 
         /// <summary>
@@ -28,7 +28,7 @@ namespace Qt.DotNet
             // Compile-time signature check of delegate vs. method
             _ = new Delegates.AddInterfaceProxy(AddInterfaceProxy);
 #endif
-            var interfaceType = Type.GetType(interfaceName)
+            var interfaceType = TypeCache.GetType(interfaceName)
                 ?? throw new ArgumentException(
                     $"Interface '{interfaceName}' not found", nameof(interfaceName));
             var proxyType = CodeGenerator.CreateInterfaceProxyType(interfaceType);
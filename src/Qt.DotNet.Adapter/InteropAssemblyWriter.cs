@@ -0,0 +1,551 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Collections.Immutable;
+using System.Diagnostics;
+using System.Reflection;
+using System.Reflection.Metadata;
+using System.Reflection.Metadata.Ecma335;
+using System.Reflection.PortableExecutable;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    /// <summary>
+    /// Writer of an interop assembly to be saved to disk (see InteropCache). The generated code
+    /// is equivalent to that of CodeGenerator: delegate types for incoming native calls, static
+    /// proxy methods for constructors and open-instance methods, and [UnmanagedCallersOnly]
+    /// trampolines. Metadata and IL are written with System.Reflection.Metadata, given that
+    /// dynamic assemblies (Reflection.Emit) cannot be saved.
+    /// </summary>
+    /// <remarks>
+    /// Types referenced by the generated code must not be generic parameters, nor be defined in
+    /// dynamic assemblies (see InteropCache.CanPersist()). Internal types of the adapter can be
+    /// referenced, given that the interop assembly ignores access checks to the adapter.
+    /// </remarks>
+    internal sealed class InteropAssemblyWriter
+    {
+        public const string Namespace = "Qt.DotNet.Interop";
+        public const string ProxyMethodName = "Invoke";
+        public const string TrampolineMethodName = "Trampoline";
+        public const string DelegateTypeSuffix = "Delegate";
+
+        private readonly MetadataBuilder metadata = new();
+        private readonly BlobBuilder ilStream = new();
+        private readonly BlobBuilder resources = new();
+        private readonly MethodBodyStreamEncoder methodBodies;
+
+        private readonly Dictionary<Assembly, AssemblyReferenceHandle> assemblyRefs = new();
+        private readonly Dictionary<Type, EntityHandle> typeRefs = new();
+        private readonly Dictionary<MethodBase, MemberReferenceHandle> methodRefs = new();
+
+        private readonly EntityHandle objectType;
+        private readonly EntityHandle multicastDelegateType;
+        private readonly StringHandle namespaceName;
+
+        public InteropAssemblyWriter(string assemblyName)
+        {
+            methodBodies = new MethodBodyStreamEncoder(ilStream);
+            metadata.AddModule(0, metadata.GetOrAddString($"{assemblyName}.dll"),
+                metadata.GetOrAddGuid(Guid.NewGuid()), default, default);
+            var assembly = metadata.AddAssembly(metadata.GetOrAddString(assemblyName),
+                new Version(1, 0, 0, 0), default, default, 0, AssemblyHashAlgorithm.None);
+
+            // <Module> must be the first type definition
+            metadata.AddTypeDefinition(default, default, metadata.GetOrAddString("<Module>"),
+                default, NextField, NextMethod);
+
+            objectType = GetTypeReference(typeof(object));
+            multicastDelegateType = GetTypeReference(typeof(MulticastDelegate));
+            namespaceName = metadata.GetOrAddString(Namespace);
+
+            AddIgnoresAccessChecksTo(assembly, typeof(InteropAssemblyWriter).Assembly);
+        }
+
+        /// <summary>
+        /// Add a delegate type that matches the signature of a given method (see
+        /// CodeGenerator.CreateDelegateTypeForMethod()).
+        /// </summary>
+        /// <param name="name">Name of the delegate type</param>
+        /// <param name="method">Information on the managed method being called</param>
+        /// <param name="parameters">Marshaling configuration of each parameter</param>
+        public void AddDelegateType(string name, MethodInfo method, Parameter[] parameters)
+        {
+            var paramInfos = method.GetParameters();
+            AddDelegateType(name, method.ReturnType,
+                paramInfos.Select(x => x.ParameterType).ToArray(),
+                paramInfos.Select(x => x.Name).ToArray(),
+                parameters);
+        }
+
+        /// <summary>
+        /// Add a type with a trampoline that calls a given static method (see
+        /// CodeGenerator.CreateTrampoline()).
+        /// </summary>
+        /// <param name="name">Name of the type</param>
+        /// <param name="method">Static method to call</param>
+        /// <param name="parameters">Marshaling configuration of each parameter</param>
+        public void AddTrampoline(string name, MethodInfo method, Parameter[] parameters)
+        {
+            metadata.AddTypeDefinition(TypeAttributes.Public | TypeAttributes.Sealed,
+                namespaceName, metadata.GetOrAddString(name), objectType, NextField, NextMethod);
+            AddTrampolineMethod(GetMethodReference(method), method.ReturnType,
+                method.GetParameters().Select(x => x.ParameterType).ToArray(), parameters);
+        }
+
+        /// <summary>
+        /// Add a type with a static proxy method that encapsulates a call to a constructor or,
+        /// with the target object as the first argument, to an instance method (see
+        /// CodeGenerator.CreateProxyMethodForCtor() and CreateProxyMethodForInstanceMethod()).
+        /// The type also includes a trampoline that calls the proxy method, if the signature
+        /// allows it, and is followed by a delegate type that matches the proxy method.
+        /// </summary>
+        /// <param name="name">Name of the type; the delegate type has the same name, followed
+        /// by DelegateTypeSuffix</param>
+        /// <param name="target">Constructor or instance method</param>
+        /// <param name="parameters">Marshaling configuration of each parameter</param>
+        public void AddProxy(string name, MethodBase target, Parameter[] parameters)
+        {
+            var targetType = target.DeclaringType;
+#if TESTS || DEBUG
+            Debug.Assert(targetType != null, "targetType is null");
+#endif
+            var code = new InstructionEncoder(new BlobBuilder());
+            Type returnType;
+            Type[] paramTypes;
+            if (target is ConstructorInfo ctor) {
+                returnType = targetType;
+                paramTypes = ctor.GetParameters().Select(x => x.ParameterType).ToArray();
+
+                // return new {targetType}([...]);
+                for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx)
+                    code.LoadArgument(paramIdx);
+                code.OpCode(ILOpCode.Newobj);
+                code.Token(GetMethodReference(ctor));
+            } else {
+                var method = (MethodInfo)target;
+                returnType = method.ReturnType;
+                paramTypes = method.GetParameters()
+                    .Select(x => x.ParameterType)
+                    .Prepend(typeof(object))
+                    .ToArray();
+
+                // this = ({targetType})arg0
+                code.LoadArgument(0);
+                code.OpCode(targetType.IsValueType ? ILOpCode.Unbox : ILOpCode.Castclass);
+                code.Token(GetTypeToken(targetType));
+
+                // return this.method([...]);
+                for (int paramIdx = 1; paramIdx < paramTypes.Length; ++paramIdx)
+                    code.LoadArgument(paramIdx);
+                code.OpCode(targetType.IsValueType ? ILOpCode.Call : ILOpCode.Callvirt);
+                code.Token(GetMethodReference(method));
+            }
+            code.OpCode(ILOpCode.Ret);
+
+            metadata.AddTypeDefinition(TypeAttributes.Public | TypeAttributes.Sealed,
+                namespaceName, metadata.GetOrAddString(name), objectType, NextField, NextMethod);
+            var proxy = AddStaticMethod(ProxyMethodName, returnType, paramTypes, code);
+            if (CodeGenerator.IsBlittableSignature(returnType, paramTypes, parameters))
+                AddTrampolineMethod(proxy, returnType, paramTypes, parameters);
+
+            AddDelegateType(
+                $"{name}{DelegateTypeSuffix}", returnType, paramTypes, null, parameters);
+        }
+
+        /// <summary>
+        /// Add a managed resource to the assembly.
+        /// </summary>
+        public void AddResource(string name, byte[] contents)
+        {
+            resources.Align(8);
+            metadata.AddManifestResource(ManifestResourceAttributes.Public,
+                metadata.GetOrAddString(name), default, (uint)resources.Count);
+            resources.WriteInt32(contents.Length);
+            resources.WriteBytes(contents);
+        }
+
+        /// <summary>
+        /// Get the image of the assembly, i.e. the contents of the assembly file.
+        /// </summary>
+        public byte[] Write()
+        {
+            var peBuilder = new ManagedPEBuilder(
+                PEHeaderBuilder.CreateLibraryHeader(),
+                new MetadataRootBuilder(metadata),
+                ilStream,
+                managedResources: resources.Count > 0 ? resources : null);
+            var image = new BlobBuilder();
+            peBuilder.Serialize(image);
+            return image.ToArray();
+        }
+
+        private void AddDelegateType(
+            string name,
+            Type returnType,
+            Type[] paramTypes,
+            string[] paramNames,
+            Parameter[] parameters)
+        {
+            metadata.AddTypeDefinition(TypeAttributes.Public | TypeAttributes.Sealed,
+                namespaceName, metadata.GetOrAddString(name), multicastDelegateType,
+                NextField, NextMethod);
+
+            // Constructor and Invoke() are implemented by the runtime
+            var ctorSignature = new BlobBuilder();
+            EncodeMethodSignature(new BlobEncoder(ctorSignature).MethodSignature(
+                isInstanceMethod: true), typeof(void), new[] { typeof(object), typeof(IntPtr) });
+            metadata.AddMethodDefinition(
+                MethodAttributes.Public | MethodAttributes.HideBySig
+                | MethodAttributes.SpecialName | MethodAttributes.RTSpecialName,
+                MethodImplAttributes.Runtime | MethodImplAttributes.Managed,
+                metadata.GetOrAddString(".ctor"), metadata.GetOrAddBlob(ctorSignature),
+                -1, NextParameter);
+
+            var invokeSignature = new BlobBuilder();
+            EncodeMethodSignature(new BlobEncoder(invokeSignature).MethodSignature(
+                isInstanceMethod: true), returnType, paramTypes);
+            metadata.AddMethodDefinition(
+                MethodAttributes.Public | MethodAttributes.HideBySig | MethodAttributes.Virtual,
+                MethodImplAttributes.Runtime | MethodImplAttributes.Managed,
+                metadata.GetOrAddString("Invoke"), metadata.GetOrAddBlob(invokeSignature),
+                -1, NextParameter);
+
+            // Return parameter (if return type is not void)
+            var returnParam = parameters[0];
+            if (!returnParam.IsVoid && GetMarshallingDescriptor(returnParam) is { } returnMarshal) {
+                var returnHandle = metadata.AddParameter(
+                    ParameterAttributes.Retval | ParameterAttributes.HasFieldMarshal,
+                    default, 0);
+                metadata.AddMarshallingDescriptor(
+                    returnHandle, metadata.GetOrAddBlob(returnMarshal));
+            }
+
+            // Method parameters
+            for (int i = 0; i < parameters.Length - 1; i++) {
+                var param = parameters[i + 1];
+                var marshal = GetMarshallingDescriptor(param);
+                var attributes = ParameterAttributes.None;
+                if (marshal != null)
+                    attributes |= ParameterAttributes.HasFieldMarshal;
+                if (param.IsIn)
+                    attributes |= ParameterAttributes.In;
+                if (param.IsOut)
+                    attributes |= ParameterAttributes.Out;
+                var paramName = paramNames?[i] is { Length: > 0 } x
+                    ? metadata.GetOrAddString(x)
+                    : default;
+                var paramHandle = metadata.AddParameter(attributes, paramName, i + 1);
+                if (marshal != null)
+                    metadata.AddMarshallingDescriptor(paramHandle, metadata.GetOrAddBlob(marshal));
+            }
+        }
+
+        private void AddTrampolineMethod(
+            EntityHandle callee,
+            Type returnType,
+            Type[] paramTypes,
+            Parameter[] parameters)
+        {
+            // Trampoline takes object references as handles, and primitives as they are
+            var nativeParamTypes = paramTypes
+                .Select((type, i) => parameters[i + 1].MarshalAs == Parameter.ObjectRef
+                    ? typeof(IntPtr) : type)
+                .ToArray();
+            var returnParam = parameters[0];
+            var returnsObjectRef = returnType != typeof(void)
+                && returnParam.MarshalAs == Parameter.ObjectRef;
+            var nativeReturnType = returnsObjectRef ? typeof(IntPtr) : returnType;
+
+            var code = new InstructionEncoder(new BlobBuilder());
+
+            // Load arguments into stack, converting handles to objects
+            for (int paramIdx = 0; paramIdx < paramTypes.Length; ++paramIdx) {
+                code.LoadArgument(paramIdx);
+                if (nativeParamTypes[paramIdx] == paramTypes[paramIdx])
+                    continue;
+                code.Call(GetMethodReference(CodeGenerator.ObjectRefToObject));
+                if (paramTypes[paramIdx].IsValueType) {
+                    code.OpCode(ILOpCode.Unbox_any);
+                    code.Token(GetTypeToken(paramTypes[paramIdx]));
+                } else if (paramTypes[paramIdx] != typeof(object)) {
+                    code.OpCode(ILOpCode.Castclass);
+                    code.Token(GetTypeToken(paramTypes[paramIdx]));
+                }
+            }
+
+            // Invoke encapsulated method
+            code.OpCode(ILOpCode.Call);
+            code.Token(callee);
+
+            // Return method result (if any), converting objects to handles
+            if (returnsObjectRef) {
+                if (returnType.IsValueType) {
+                    code.OpCode(ILOpCode.Box);
+                    code.Token(GetTypeToken(returnType));
+                }
+                code.Call(GetMethodReference(returnParam.IsWeakRef
+                    ? CodeGenerator.ObjectToWeakObjectRef
+                    : CodeGenerator.ObjectToObjectRef));
+            }
+            code.OpCode(ILOpCode.Ret);
+
+            var trampoline = AddStaticMethod(
+                TrampolineMethodName, nativeReturnType, nativeParamTypes, code);
+            var attributeValue = new BlobBuilder();
+            attributeValue.WriteUInt16(1); // Prolog
+            attributeValue.WriteUInt16(0); // No named arguments
+            metadata.AddCustomAttribute(trampoline,
+                GetMethodReference(UnmanagedCallersOnlyCtor),
+                metadata.GetOrAddBlob(attributeValue));
+        }
+
+        /// <summary>
+        /// Allow the generated code to access internal types and members of an assembly, e.g.
+        /// the marshaler of object references and the conversions used by trampolines. The
+        /// runtime honors IgnoresAccessChecksToAttribute if it is defined in the accessing
+        /// assembly itself.
+        /// </summary>
+        private void AddIgnoresAccessChecksTo(
+            AssemblyDefinitionHandle assembly,
+            Assembly accessedAssembly)
+        {
+            metadata.AddTypeDefinition(TypeAttributes.NotPublic | TypeAttributes.Sealed,
+                metadata.GetOrAddString("System.Runtime.CompilerServices"),
+                metadata.GetOrAddString("IgnoresAccessChecksToAttribute"),
+                GetTypeReference(typeof(Attribute)), NextField, NextMethod);
+
+            // .ctor(string assemblyName) : base() { }
+            var code = new InstructionEncoder(new BlobBuilder());
+            code.LoadArgument(0);
+            code.Call(GetMethodReference(AttributeCtor));
+            code.OpCode(ILOpCode.Ret);
+            var ctorSignature = new BlobBuilder();
+            EncodeMethodSignature(new BlobEncoder(ctorSignature).MethodSignature(
+                isInstanceMethod: true), typeof(void), new[] { typeof(string) });
+            var ctor = metadata.AddMethodDefinition(
+                MethodAttributes.Public | MethodAttributes.HideBySig
+                | MethodAttributes.SpecialName | MethodAttributes.RTSpecialName,
+                MethodImplAttributes.IL, metadata.GetOrAddString(".ctor"),
+                metadata.GetOrAddBlob(ctorSignature), methodBodies.AddMethodBody(code, 1),
+                NextParameter);
+
+            var attributeValue = new BlobBuilder();
+            attributeValue.WriteUInt16(1); // Prolog
+            attributeValue.WriteSerializedString(accessedAssembly.GetName().Name);
+            attributeValue.WriteUInt16(0); // No named arguments
+            metadata.AddCustomAttribute(assembly, ctor, metadata.GetOrAddBlob(attributeValue));
+        }
+
+        private MethodDefinitionHandle AddStaticMethod(
+            string name,
+            Type returnType,
+            Type[] paramTypes,
+            InstructionEncoder code)
+        {
+            var signature = new BlobBuilder();
+            EncodeMethodSignature(
+                new BlobEncoder(signature).MethodSignature(), returnType, paramTypes);
+            var bodyOffset = methodBodies.AddMethodBody(code, paramTypes.Length + 1);
+            return metadata.AddMethodDefinition(
+                MethodAttributes.Public | MethodAttributes.HideBySig | MethodAttributes.Static,
+                MethodImplAttributes.IL, metadata.GetOrAddString(name),
+                metadata.GetOrAddBlob(signature), bodyOffset, NextParameter);
+        }
+
+        /// <summary>
+        /// Marshaling descriptor of a parameter, equivalent to the [MarshalAs] attribute set by
+        /// CodeGenerator.SetMarshalAs(); null if the default marshaling applies.
+        /// </summary>
+        private static BlobBuilder GetMarshallingDescriptor(Parameter parameter)
+        {
+            var descriptor = new BlobBuilder();
+            if (parameter.MarshalAs == Parameter.ObjectRef) {
+                WriteCustomMarshaler(descriptor, typeof(ObjectMarshaler),
+                    parameter.IsWeakRef ? "weak" : "normal");
+            } else if (parameter.MarshalAs == UnmanagedType.CustomMarshaler) {
+                WriteCustomMarshaler(descriptor, TypeCache.GetType(parameter.TypeName),
+                    parameter.TypeName);
+            } else if (parameter.MarshalAs != 0) {
+                if (parameter.IsArray) {
+                    descriptor.WriteByte((byte)UnmanagedType.LPArray);
+                    descriptor.WriteByte((byte)parameter.MarshalAs);
+                    if (parameter.IsFixedLength) {
+                        // No parameter index, element count, parameter index is not valid
+                        descriptor.WriteCompressedInteger(0);
+                        descriptor.WriteCompressedInteger(parameter.ArrayLength);
+                        descriptor.WriteByte(0);
+                    } else {
+                        descriptor.WriteCompressedInteger(parameter.ArrayLength);
+                    }
+                } else {
+                    descriptor.WriteByte((byte)parameter.MarshalAs);
+                }
+            } else {
+                return null;
+            }
+            return descriptor;
+        }
+
+        private static void WriteCustomMarshaler(BlobBuilder descriptor, Type type, string cookie)
+        {
+            descriptor.WriteByte((byte)UnmanagedType.CustomMarshaler);
+            descriptor.WriteSerializedString(string.Empty); // GUID (unused)
+            descriptor.WriteSerializedString(string.Empty); // Native type name (unused)
+            descriptor.WriteSerializedString(type.AssemblyQualifiedName);
+            descriptor.WriteSerializedString(cookie ?? string.Empty);
+        }
+
+        private void EncodeMethodSignature(
+            MethodSignatureEncoder encoder,
+            Type returnType,
+            Type[] paramTypes)
+        {
+            encoder.Parameters(paramTypes.Length, out var returnEncoder, out var paramsEncoder);
+            if (returnType == typeof(void))
+                returnEncoder.Void();
+            else
+                EncodeType(returnEncoder.Type(returnType.IsByRef), WithoutByRef(returnType));
+            foreach (var type in paramTypes)
+                EncodeType(paramsEncoder.AddParameter().Type(type.IsByRef), WithoutByRef(type));
+        }
+
+        private static Type WithoutByRef(Type type) => type.IsByRef ? type.GetElementType() : type;
+
+        private void EncodeType(SignatureTypeEncoder encoder, Type type)
+        {
+            if (type.IsPointer) {
+                var elementType = type.GetElementType();
+                if (elementType == typeof(void))
+                    encoder.VoidPointer();
+                else
+                    EncodeType(encoder.Pointer(), elementType);
+            } else if (type.IsSZArray) {
+                EncodeType(encoder.SZArray(), type.GetElementType());
+            } else if (type.IsArray) {
+                encoder.Array(out var elementEncoder, out var shapeEncoder);
+                EncodeType(elementEncoder, type.GetElementType());
+                var rank = type.GetArrayRank();
+                shapeEncoder.Shape(rank, ImmutableArray<int>.Empty,
+                    ImmutableArray.CreateRange(Enumerable.Repeat(0, rank)));
+            } else if (type.IsConstructedGenericType) {
+                var typeArgs = type.GenericTypeArguments;
+                var argsEncoder = encoder.GenericInstantiation(
+                    GetTypeReference(type.GetGenericTypeDefinition()), typeArgs.Length,
+                    type.IsValueType);
+                foreach (var typeArg in typeArgs)
+                    EncodeType(argsEncoder.AddArgument(), typeArg);
+            } else if (type == typeof(object)) {
+                encoder.Object();
+            } else if (type == typeof(IntPtr)) {
+                encoder.IntPtr();
+            } else if (type == typeof(UIntPtr)) {
+                encoder.UIntPtr();
+            } else if (type.IsPrimitive || type == typeof(string)) {
+                switch (Type.GetTypeCode(type)) {
+                case TypeCode.Boolean: encoder.Boolean(); break;
+                case TypeCode.Char: encoder.Char(); break;
+                case TypeCode.SByte: encoder.SByte(); break;
+                case TypeCode.Byte: encoder.Byte(); break;
+                case TypeCode.Int16: encoder.Int16(); break;
+                case TypeCode.UInt16: encoder.UInt16(); break;
+                case TypeCode.Int32: encoder.Int32(); break;
+                case TypeCode.UInt32: encoder.UInt32(); break;
+                case TypeCode.Int64: encoder.Int64(); break;
+                case TypeCode.UInt64: encoder.UInt64(); break;
+                case TypeCode.Single: encoder.Single(); break;
+                case TypeCode.Double: encoder.Double(); break;
+                case TypeCode.String: encoder.String(); break;
+                default: throw new NotSupportedException($"Type '{type}' not supported");
+                }
+            } else if (type.IsGenericParameter) {
+                throw new NotSupportedException($"Type '{type}' not supported");
+            } else {
+                encoder.Type(GetTypeReference(type), type.IsValueType);
+            }
+        }
+
+        /// <summary>
+        /// Token of a type, as an operand of e.g. castclass: a type reference for named types,
+        /// a type specification otherwise (e.g. arrays).
+        /// </summary>
+        private EntityHandle GetTypeToken(Type type)
+        {
+            if (!type.HasElementType && !type.IsConstructedGenericType)
+                return GetTypeReference(type);
+            var signature = new BlobBuilder();
+            EncodeType(new BlobEncoder(signature).TypeSpecificationSignature(), type);
+            return metadata.AddTypeSpecification(metadata.GetOrAddBlob(signature));
+        }
+
+        private EntityHandle GetTypeReference(Type type)
+        {
+            if (typeRefs.TryGetValue(type, out var handle))
+                return handle;
+            if (type.IsNested) {
+                handle = metadata.AddTypeReference(GetTypeReference(type.DeclaringType),
+                    default, metadata.GetOrAddString(type.Name));
+            } else {
+                handle = metadata.AddTypeReference(GetAssemblyReference(type.Assembly),
+                    string.IsNullOrEmpty(type.Namespace)
+                        ? default
+                        : metadata.GetOrAddString(type.Namespace),
+                    metadata.GetOrAddString(type.Name));
+            }
+            typeRefs.Add(type, handle);
+            return handle;
+        }
+
+        private AssemblyReferenceHandle GetAssemblyReference(Assembly assembly)
+        {
+            if (assemblyRefs.TryGetValue(assembly, out var handle))
+                return handle;
+            var name = assembly.GetName();
+            var publicKeyToken = name.GetPublicKeyToken();
+            handle = metadata.AddAssemblyReference(
+                metadata.GetOrAddString(name.Name),
+                name.Version ?? new Version(0, 0, 0, 0),
+                string.IsNullOrEmpty(name.CultureName)
+                    ? default
+                    : metadata.GetOrAddString(name.CultureName),
+                publicKeyToken is { Length: > 0 } ? metadata.GetOrAddBlob(publicKeyToken) : default,
+                default, default);
+            assemblyRefs.Add(assembly, handle);
+            return handle;
+        }
+
+        private MemberReferenceHandle GetMethodReference(MethodBase method)
+        {
+            if (methodRefs.TryGetValue(method, out var handle))
+                return handle;
+            var signature = new BlobBuilder();
+            EncodeMethodSignature(
+                new BlobEncoder(signature).MethodSignature(isInstanceMethod: !method.IsStatic),
+                method is MethodInfo methodInfo ? methodInfo.ReturnType : typeof(void),
+                method.GetParameters().Select(x => x.ParameterType).ToArray());
+            handle = metadata.AddMemberReference(GetTypeReference(method.DeclaringType),
+                metadata.GetOrAddString(method.Name), metadata.GetOrAddBlob(signature));
+            methodRefs.Add(method, handle);
+            return handle;
+        }
+
+        private FieldDefinitionHandle NextField
+            => MetadataTokens.FieldDefinitionHandle(metadata.GetRowCount(TableIndex.Field) + 1);
+
+        private MethodDefinitionHandle NextMethod
+            => MetadataTokens.MethodDefinitionHandle(
+                metadata.GetRowCount(TableIndex.MethodDef) + 1);
+
+        private ParameterHandle NextParameter
+            => MetadataTokens.ParameterHandle(metadata.GetRowCount(TableIndex.Param) + 1);
+
+        private static ConstructorInfo AttributeCtor { get; }
+            = typeof(Attribute).GetConstructor(
+                BindingFlags.Instance | BindingFlags.NonPublic, null, Type.EmptyTypes, null);
+
+        private static ConstructorInfo UnmanagedCallersOnlyCtor { get; }
+            = typeof(UnmanagedCallersOnlyAttribute).GetConstructor(Type.EmptyTypes);
+    }
+}
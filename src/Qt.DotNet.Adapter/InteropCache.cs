@@ -0,0 +1,500 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Collections.Concurrent;
+using System.Globalization;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Runtime.Loader;
+using System.Text;
+
+namespace Qt.DotNet
+{
+    /// <summary>
+    /// Persistent cache of generated interop code. If enabled, the delegate types, proxy methods
+    /// and trampolines generated for the methods of an assembly (see CodeGenerator) are saved to
+    /// an interop assembly in the cache directory; the next time the same methods are resolved
+    /// with the same signatures, the generated code is loaded from there instead.
+    /// </summary>
+    /// <remarks>
+    /// The cache is enabled by setting the runtime property "Qt.DotNet.CodeCache" to the path of
+    /// the cache directory (see QDotNetHostOptions::setCodeCacheDirectory()). Interop assemblies
+    /// are keyed by the MVID of the target module, so they are not used once the target assembly
+    /// is rebuilt; a manifest in each interop assembly lists the method and signature of each
+    /// entry. Safe methods and interface proxies are always generated at run-time.
+    /// </remarks>
+    internal static class InteropCache
+    {
+        public const string DirectoryProperty = "Qt.DotNet.CodeCache";
+
+        public enum EntryKind { Delegate, Trampoline, Proxy }
+
+        /// <summary>
+        /// Get the delegate type generated in a previous run for a method and signature.
+        /// </summary>
+        /// <returns>Delegate type, or null if not found</returns>
+        public static Type GetDelegateType(MethodInfo method, Signature signature)
+        {
+            return GetModuleCache(method)?.GetDelegateType(method, signature.Parameters);
+        }
+
+        /// <summary>
+        /// Get the trampoline generated in a previous run for a static method and signature.
+        /// </summary>
+        /// <returns>Trampoline method, or null if not found</returns>
+        public static MethodInfo GetTrampoline(MethodInfo method, Signature signature)
+        {
+            return GetModuleCache(method)?.GetTrampoline(method, signature.Parameters);
+        }
+
+        /// <summary>
+        /// Get the proxy method generated in a previous run for a constructor or an open-instance
+        /// method, and signature.
+        /// </summary>
+        /// <param name="target">Constructor or instance method</param>
+        /// <param name="signature">Marshaling configuration of each parameter</param>
+        /// <param name="delegateType">Delegate type that matches the proxy method</param>
+        /// <param name="trampoline">Trampoline that calls the proxy method, or null if the
+        /// signature does not allow it</param>
+        /// <returns>Proxy method, or null if not found</returns>
+        public static MethodInfo GetProxyMethod(
+            MethodBase target,
+            Signature signature,
+            out Type delegateType,
+            out MethodInfo trampoline)
+        {
+            delegateType = null;
+            trampoline = null;
+            return GetModuleCache(target)?.GetProxyMethod(
+                target, signature.Parameters, out delegateType, out trampoline);
+        }
+
+        /// <summary>
+        /// Add generated code to the cache, to be saved to the interop assembly of the target
+        /// module. Nothing is added if the code cannot be persisted (see CanPersist()).
+        /// </summary>
+        /// <param name="kind">Kind of generated code</param>
+        /// <param name="target">Method being called</param>
+        /// <param name="signature">Marshaling configuration of each parameter</param>
+        public static void Add(EntryKind kind, MethodBase target, Signature signature)
+        {
+            var cache = GetModuleCache(target);
+            if (cache != null && cache.Add(kind, target, signature.Parameters))
+                SaveTimer.Change(SaveDelay, Timeout.Infinite);
+        }
+
+        /// <summary>
+        /// Save the interop assemblies that have new entries.
+        /// </summary>
+        public static void Save()
+        {
+            foreach (var cache in Modules.Values.Where(x => x.IsValueCreated)) {
+                if (cache.Value is not { IsModified: true } moduleCache)
+                    continue;
+                var path = GetPath(moduleCache.Module);
+                var tempPath = $"{path}.{Environment.ProcessId}.tmp";
+                try {
+                    Directory.CreateDirectory(CacheDirectory);
+                    File.WriteAllBytes(tempPath, moduleCache.Write());
+                    File.Move(tempPath, path, true);
+                    DeleteOutdated(moduleCache.Module, path);
+                } catch (Exception) {
+                    try {
+                        File.Delete(tempPath);
+                    } catch (Exception) {
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Check if generated code can be saved: the target must be a public, non-generic method
+        /// of a non-generic type, and all types referenced by the generated code must be visible
+        /// (or internal to the adapter) and defined in assemblies that the interop assembly can
+        /// reference, i.e. in the load context of the target module or in the default load
+        /// context.
+        /// </summary>
+        public static bool CanPersist(EntryKind kind, MethodBase target, Parameter[] parameters)
+        {
+            var declaringType = target.DeclaringType;
+            // Methods of generic types share their metadata token with other instantiations
+            if (declaringType is not { IsVisible: true, IsGenericType: false })
+                return false;
+            if (target.ContainsGenericParameters || target.IsGenericMethod || !target.IsPublic)
+                return false;
+            if (target.CallingConvention.HasFlag(CallingConventions.VarArgs))
+                return false;
+            if (AssemblyLoadContext.GetLoadContext(target.Module.Assembly)
+                is not { IsCollectible: false } loadContext) {
+                return false;
+            }
+
+            var paramInfos = target.GetParameters();
+            var expectedLength = paramInfos.Length
+                + (kind == EntryKind.Proxy && target is MethodInfo ? 2 : 1);
+            if (parameters.Length != expectedLength)
+                return false;
+            var returnInfo = (target as MethodInfo)?.ReturnParameter;
+            switch (kind) {
+            case EntryKind.Delegate when target is not MethodInfo:
+            case EntryKind.Trampoline when target is not MethodInfo { IsStatic: true }:
+            case EntryKind.Proxy when target.IsStatic:
+                return false;
+            case EntryKind.Trampoline:
+            case EntryKind.Proxy:
+                // Generated code calls the target, so the signatures must match exactly
+                if (paramInfos.Append(returnInfo).Any(x => x != null
+                    && (x.GetRequiredCustomModifiers().Length > 0
+                        || x.GetOptionalCustomModifiers().Length > 0))) {
+                    return false;
+                }
+                break;
+            }
+
+            bool CanReference(Type type)
+            {
+                if (type.HasElementType)
+                    return CanReference(type.GetElementType());
+                if (type.IsGenericParameter)
+                    return false;
+                // Interop assemblies can access internal types of the adapter, e.g. the
+                // marshaler of object references (see InteropAssemblyWriter)
+                if (!type.IsVisible && type.Assembly != typeof(InteropCache).Assembly)
+                    return false;
+                if (type.IsConstructedGenericType && !type.GenericTypeArguments.All(CanReference))
+                    return false;
+                if (type.Assembly.IsDynamic)
+                    return false;
+                var typeLoadContext = AssemblyLoadContext.GetLoadContext(type.Assembly);
+                return typeLoadContext == loadContext
+                    || typeLoadContext == AssemblyLoadContext.Default;
+            }
+
+            // Object references are marshaled, or converted in trampolines, by the adapter
+            var types = paramInfos
+                .Select(x => x.ParameterType)
+                .Append(declaringType)
+                .Append(returnInfo?.ParameterType ?? typeof(void));
+            if (parameters.Any(x => x.MarshalAs == Parameter.ObjectRef))
+                types = types.Append(typeof(ObjectMarshaler));
+            foreach (var parameter in parameters) {
+                if (parameter.MarshalAs != UnmanagedType.CustomMarshaler)
+                    continue;
+                if (TypeCache.GetType(parameter.TypeName) is not { } marshalerType)
+                    return false;
+                types = types.Append(marshalerType);
+            }
+            return types.All(CanReference);
+        }
+
+        /// <summary>
+        /// Generated code of a target module, loaded from and saved to an interop assembly.
+        /// </summary>
+        internal sealed class ModuleCache
+        {
+            public Module Module { get; }
+            public string AssemblyName { get; }
+            public bool IsModified { get; private set; }
+
+            public int Count
+            {
+                get
+                {
+                    lock (entries)
+                        return entries.Count;
+                }
+            }
+
+            // Interop assembly, and names of the types of its entries (loaded entries come
+            // first in the list of entries)
+            private Assembly assembly;
+            private readonly List<string> typeNames = new();
+
+            private readonly List<Entry> entries = new();
+            private readonly Dictionary<(EntryKind, int, string), int> index = new();
+
+            private sealed record Entry(EntryKind Kind, int Token, Parameter[] Parameters);
+
+            public ModuleCache(Module module, string assemblyName)
+            {
+                Module = module;
+                AssemblyName = assemblyName;
+            }
+
+            /// <summary>
+            /// Load the interop assembly of the module.
+            /// </summary>
+            /// <param name="image">Contents of the assembly file</param>
+            /// <returns>'true' if the assembly was loaded; 'false' otherwise</returns>
+            public bool Load(byte[] image)
+            {
+                var loadContext = AssemblyLoadContext.GetLoadContext(Module.Assembly);
+                if (loadContext == null || assembly != null)
+                    return false;
+                try {
+                    var interopAssembly = loadContext.LoadFromStream(new MemoryStream(image));
+                    using var manifest = interopAssembly.GetManifestResourceStream(ManifestName);
+                    if (manifest == null)
+                        return false;
+                    if (ReadManifest(manifest) is not { } loaded)
+                        return false;
+                    lock (entries) {
+                        foreach (var (entry, name) in loaded) {
+                            if (!index.TryAdd(
+                                (entry.Kind, entry.Token, GetKey(entry.Parameters)),
+                                entries.Count)) {
+                                continue;
+                            }
+                            entries.Add(entry);
+                            typeNames.Add(name);
+                        }
+                        assembly = interopAssembly;
+                    }
+                    InteropAssemblies.TryAdd(interopAssembly, 0);
+                    return true;
+                } catch (Exception) {
+                    return false;
+                }
+            }
+
+            public Type GetDelegateType(MethodBase method, Parameter[] parameters)
+            {
+                return GetEntryType(EntryKind.Delegate, method, parameters);
+            }
+
+            public MethodInfo GetTrampoline(MethodBase method, Parameter[] parameters)
+            {
+                return GetEntryType(EntryKind.Trampoline, method, parameters)?
+                    .GetMethod(InteropAssemblyWriter.TrampolineMethodName);
+            }
+
+            public MethodInfo GetProxyMethod(
+                MethodBase target,
+                Parameter[] parameters,
+                out Type delegateType,
+                out MethodInfo trampoline)
+            {
+                delegateType = null;
+                trampoline = null;
+                var proxyType = GetEntryType(EntryKind.Proxy, target, parameters);
+                if (proxyType == null)
+                    return null;
+                delegateType = proxyType.Assembly.GetType(
+                    $"{proxyType.FullName}{InteropAssemblyWriter.DelegateTypeSuffix}");
+                trampoline = proxyType.GetMethod(InteropAssemblyWriter.TrampolineMethodName);
+                var proxy = proxyType.GetMethod(InteropAssemblyWriter.ProxyMethodName);
+                return delegateType != null ? proxy : null;
+            }
+
+            /// <summary>
+            /// Add an entry, to be saved with the next Write().
+            /// </summary>
+            /// <returns>'true' if the entry was added; 'false' if it already exists or if it
+            /// cannot be persisted</returns>
+            public bool Add(EntryKind kind, MethodBase target, Parameter[] parameters)
+            {
+                if (target.Module != Module || !CanPersist(kind, target, parameters))
+                    return false;
+                var entry = new Entry(kind, target.MetadataToken, parameters);
+                lock (entries) {
+                    if (!index.TryAdd((kind, entry.Token, GetKey(parameters)), entries.Count))
+                        return false;
+                    entries.Add(entry);
+                    IsModified = true;
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// Write an interop assembly with all entries, i.e. entries loaded from the previous
+            /// interop assembly and entries added since. Entries whose target can no longer be
+            /// found are left out.
+            /// </summary>
+            /// <returns>Contents of the assembly file</returns>
+            public byte[] Write()
+            {
+                Entry[] snapshot;
+                lock (entries) {
+                    snapshot = entries.ToArray();
+                    IsModified = false;
+                }
+
+                var writer = new InteropAssemblyWriter(AssemblyName);
+                var manifest = new StringBuilder().AppendLine(ManifestHeader);
+                for (int i = 0; i < snapshot.Length; ++i) {
+                    var entry = snapshot[i];
+                    MethodBase target;
+                    try {
+                        target = Module.ResolveMethod(entry.Token);
+                    } catch (ArgumentException) {
+                        continue;
+                    }
+                    if (target == null || !CanPersist(entry.Kind, target, entry.Parameters))
+                        continue;
+                    var name = GetTypeName(i);
+                    switch (entry.Kind) {
+                    case EntryKind.Delegate when target is MethodInfo method:
+                        writer.AddDelegateType(name, method, entry.Parameters);
+                        break;
+                    case EntryKind.Trampoline when target is MethodInfo method:
+                        writer.AddTrampoline(name, method, entry.Parameters);
+                        break;
+                    case EntryKind.Proxy:
+                        writer.AddProxy(name, target, entry.Parameters);
+                        break;
+                    default:
+                        continue;
+                    }
+                    manifest
+                        .Append(entry.Kind).Append(Separator)
+                        .Append(entry.Token.ToString("X8", CultureInfo.InvariantCulture))
+                        .Append(Separator)
+                        .Append(i).Append(Separator)
+                        .AppendLine(GetKey(entry.Parameters));
+                }
+                writer.AddResource(ManifestName, Encoding.UTF8.GetBytes(manifest.ToString()));
+                return writer.Write();
+            }
+
+            private Type GetEntryType(EntryKind kind, MethodBase target, Parameter[] parameters)
+            {
+                Assembly interopAssembly;
+                string typeName;
+                lock (entries) {
+                    if (assembly == null || !index.TryGetValue(
+                        (kind, target.MetadataToken, GetKey(parameters)), out var entryIndex)) {
+                        return null;
+                    }
+                    // Entries added since the interop assembly was loaded are not in it
+                    if (entryIndex >= typeNames.Count)
+                        return null;
+                    interopAssembly = assembly;
+                    typeName = typeNames[entryIndex];
+                }
+                try {
+                    return interopAssembly.GetType($"{InteropAssemblyWriter.Namespace}.{typeName}");
+                } catch (Exception) {
+                    return null;
+                }
+            }
+
+            private static List<(Entry, string)> ReadManifest(Stream manifest)
+            {
+                using var reader = new StreamReader(manifest, Encoding.UTF8);
+                if (reader.ReadLine() != ManifestHeader)
+                    return null;
+                var loaded = new List<(Entry, string)>();
+                while (reader.ReadLine() is { } line) {
+                    var fields = line.Split(Separator);
+                    if (fields.Length < 4
+                        || !Enum.TryParse<EntryKind>(fields[0], out var kind)
+                        || !int.TryParse(fields[1], NumberStyles.HexNumber,
+                            CultureInfo.InvariantCulture, out var token)
+                        || !int.TryParse(fields[2], out var entryIndex)
+                        || !int.TryParse(fields[3], out var parameterCount)
+                        || fields.Length != 4 + 2 * parameterCount) {
+                        return null;
+                    }
+                    var parameters = new Parameter[parameterCount];
+                    for (int i = 0; i < parameterCount; ++i) {
+                        if (!ulong.TryParse(fields[5 + 2 * i], out var paramInfo))
+                            return null;
+                        parameters[i] = new Parameter(fields[4 + 2 * i], paramInfo);
+                    }
+                    loaded.Add((new Entry(kind, token, parameters), GetTypeName(entryIndex)));
+                }
+                return loaded;
+            }
+
+            private static string GetTypeName(int entryIndex) => $"Entry{entryIndex}";
+        }
+
+        /// <summary>
+        /// Text representation of a list of parameters: the number of parameters, followed by
+        /// the type name and parameter info of each parameter.
+        /// </summary>
+        private static string GetKey(Parameter[] parameters)
+        {
+            var key = new StringBuilder().Append(parameters.Length);
+            foreach (var parameter in parameters) {
+                key.Append(Separator).Append(parameter.TypeName ?? string.Empty)
+                    .Append(Separator).Append(parameter.ParamInfo);
+            }
+            return key.ToString();
+        }
+
+        private static ModuleCache GetModuleCache(MethodBase method)
+        {
+            // Lightweight methods (i.e. DynamicMethod) have no declaring type
+            if (!IsEnabled || method.DeclaringType == null || method.Module.Assembly.IsDynamic)
+                return null;
+            if (InteropAssemblies.ContainsKey(method.Module.Assembly))
+                return null;
+            return Modules.GetOrAdd(method.Module, module => new Lazy<ModuleCache>(() =>
+            {
+                var cache = new ModuleCache(module, $"QtDotNetInterop.{module.ModuleVersionId:N}");
+                try {
+                    var path = GetPath(module);
+                    if (File.Exists(path))
+                        cache.Load(File.ReadAllBytes(path));
+                } catch (Exception) {
+                }
+                return cache;
+            })).Value;
+        }
+
+        /// <summary>
+        /// Path of the interop assembly of a module: the target assembly name, followed by the
+        /// module MVID.
+        /// </summary>
+        private static string GetPath(Module module)
+        {
+            return Path.Combine(CacheDirectory,
+                $"{module.Assembly.GetName().Name}.{module.ModuleVersionId:N}{FileSuffix}");
+        }
+
+        /// <summary>
+        /// Delete interop assemblies generated for previous builds of a target assembly.
+        /// </summary>
+        private static void DeleteOutdated(Module module, string path)
+        {
+            var pattern = $"{module.Assembly.GetName().Name}.*{FileSuffix}";
+            foreach (var outdatedPath in Directory.EnumerateFiles(CacheDirectory, pattern)) {
+                var mvid = Path.GetFileName(outdatedPath)
+                    [(module.Assembly.GetName().Name.Length + 1)..^FileSuffix.Length];
+                if (outdatedPath != path && Guid.TryParseExact(mvid, "N", out _))
+                    File.Delete(outdatedPath);
+            }
+        }
+
+        private const string ManifestHeader = "#qtdotnet-interop 1";
+        private const string ManifestName = "Qt.DotNet.Interop.Manifest";
+        private const string FileSuffix = ".interop.dll";
+        private const char Separator = '\t';
+
+        /// <summary>
+        /// Delay after the last new entry before interop assemblies are saved, in milliseconds.
+        /// </summary>
+        private const int SaveDelay = 1000;
+
+        private static string CacheDirectory { get; }
+            = AppContext.GetData(DirectoryProperty) as string;
+
+        public static bool IsEnabled => !string.IsNullOrEmpty(CacheDirectory);
+
+        private static ConcurrentDictionary<Module, Lazy<ModuleCache>> Modules { get; } = new();
+
+        private static ConcurrentDictionary<Assembly, byte> InteropAssemblies { get; } = new();
+
+        private static Timer SaveTimer { get; }
+            = new(_ => Save(), null, Timeout.Infinite, Timeout.Infinite);
+
+        static InteropCache()
+        {
+            if (IsEnabled)
+                AppDomain.CurrentDomain.ProcessExit += (_, _) => Save();
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+namespace Qt.DotNet
+{
+    /// <summary>
+    /// Thread-safe cache with a maximum number of entries. When the cache is full, adding an
+    /// entry evicts the least recently used one.
+    /// </summary>
+    internal sealed class LruCache<TKey, TValue>
+    {
+        /// <summary>
+        /// Create an empty cache.
+        /// </summary>
+        /// <param name="capacity">Maximum number of entries</param>
+        /// <param name="removed">Called for each entry that is evicted or removed</param>
+        public LruCache(int capacity, Action<TKey, TValue> removed = null)
+        {
+            if (capacity <= 0)
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+            Capacity = capacity;
+            Removed = removed;
+        }
+
+        public int Capacity { get; }
+
+        public int Count
+        {
+            get
+            {
+                lock (Index)
+                    return Index.Count;
+            }
+        }
+
+        public bool TryGetValue(TKey key, out TValue value)
+        {
+            lock (Index) {
+                if (!Index.TryGetValue(key, out var node)) {
+                    value = default;
+                    return false;
+                }
+                Touch(node);
+                value = node.Value.Value;
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Add an entry, if the key is not in the cache.
+        /// </summary>
+        /// <returns>Value in the cache, i.e. the existing value or the one added</returns>
+        public TValue GetOrAdd(TKey key, TValue value)
+        {
+            var (cachedValue, _, evicted) = Add(key, value);
+            if (evicted is { } entry)
+                Removed?.Invoke(entry.Key, entry.Value);
+            return cachedValue;
+        }
+
+        /// <summary>
+        /// Add an entry, if the key is not in the cache.
+        /// </summary>
+        /// <returns>true if added; false if the key was already in the cache</returns>
+        public bool TryAdd(TKey key, TValue value)
+        {
+            var (_, added, evicted) = Add(key, value);
+            if (evicted is { } entry)
+                Removed?.Invoke(entry.Key, entry.Value);
+            return added;
+        }
+
+        /// <summary>
+        /// Remove all entries that match a condition.
+        /// </summary>
+        /// <returns>Number of entries removed</returns>
+        public int RemoveWhere(Func<TKey, TValue, bool> predicate)
+        {
+            List<(TKey Key, TValue Value)> removed;
+            lock (Index) {
+                removed = Entries
+                    .Where(x => predicate(x.Key, x.Value))
+                    .ToList();
+                foreach (var entry in removed) {
+                    Entries.Remove(Index[entry.Key]);
+                    Index.Remove(entry.Key);
+                }
+            }
+            if (Removed != null)
+                removed.ForEach(x => Removed(x.Key, x.Value));
+            return removed.Count;
+        }
+
+        private (TValue Value, bool Added, (TKey Key, TValue Value)? Evicted) Add(
+            TKey key,
+            TValue value)
+        {
+            lock (Index) {
+                if (Index.TryGetValue(key, out var node)) {
+                    Touch(node);
+                    return (node.Value.Value, false, null);
+                }
+                (TKey Key, TValue Value)? evicted = null;
+                if (Index.Count >= Capacity && Entries.Last is { } lastNode) {
+                    evicted = lastNode.Value;
+                    Entries.RemoveLast();
+                    Index.Remove(lastNode.Value.Key);
+                }
+                Index.Add(key, Entries.AddFirst((key, value)));
+                return (value, true, evicted);
+            }
+        }
+
+        // Move entry to the front, i.e. most recently used
+        private void Touch(LinkedListNode<(TKey Key, TValue Value)> node)
+        {
+            if (node == Entries.First)
+                return;
+            Entries.Remove(node);
+            Entries.AddFirst(node);
+        }
+
+        private Dictionary<TKey, LinkedListNode<(TKey Key, TValue Value)>> Index { get; } = new();
+        private LinkedList<(TKey Key, TValue Value)> Entries { get; } = new();
+        private Action<TKey, TValue> Removed { get; }
+    }
+}
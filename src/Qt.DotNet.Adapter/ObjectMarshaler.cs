@@ -27,13 +27,23 @@ namespace Qt.DotNet
         }
 
         public IntPtr MarshalManagedToNative(object obj)
+        {
+            return ToNative(obj, useWeakRefs);
+        }
+
+        public object MarshalNativeToManaged(IntPtr objRefPtr)
+        {
+            return ToManaged(objRefPtr);
+        }
+
+        internal static IntPtr ToNative(object obj, bool weakRef)
         {
             if (obj == null)
                 return IntPtr.Zero;
-            return Adapter.GetRefPtrToObject(obj, useWeakRefs);
+            return Adapter.GetRefPtrToObject(obj, weakRef);
         }
 
-        public object MarshalNativeToManaged(IntPtr objRefPtr)
+        internal static object ToManaged(IntPtr objRefPtr)
         {
             if (objRefPtr == IntPtr.Zero)
                 return null;
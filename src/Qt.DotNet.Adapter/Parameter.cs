@@ -4,7 +4,6 @@
 ***************************************************************************************************/
 
 using System.Diagnostics;
-using System.Reflection;
 using System.Runtime.InteropServices;
 
 namespace Qt.DotNet
@@ -39,6 +38,8 @@ namespace Qt.DotNet
         const int FLAGS_ARRAY_BIT = 2;
         const int FLAGS_FIXEDLENGTH_BIT = 3;
         const int FLAGS_WEAKREF_BIT = 4;
+        const int FLAGS_PREPARE_BIT = 5;
+        const int FLAGS_PREPARE_SIZE = 2;
 
         const int ARRAYLENGTH_OFFSET = FLAGS_OFFSET + FLAGS_SIZE;
         const int ARRAYLENGTH_SIZE = 32;
@@ -51,20 +52,14 @@ namespace Qt.DotNet
             if (IsVoid)
                 return typeof(void);
             if (MarshalAs == UnmanagedType.CustomMarshaler) {
-                Type customMarshalerType = Type.GetType(TypeName);
+                Type customMarshalerType = TypeCache.GetType(TypeName);
 #if TEST || DEBUG
                 Debug.Assert(customMarshalerType != null, nameof(customMarshalerType) + " is null");
 #endif
-                if (customMarshalerType.IsAssignableTo(typeof(IAdapterCustomMarshaler))) {
-                    var nativeType = customMarshalerType.GetProperty(
-                        "NativeType", BindingFlags.Public | BindingFlags.Static);
-                    if (nativeType != null && nativeType.GetValue(null) is Type customType)
-                        return customType;
-                }
-                return typeof(object);
+                return TypeCache.GetCustomNativeType(customMarshalerType);
             }
             if (!string.IsNullOrEmpty(TypeName))
-                return Type.GetType(TypeName);
+                return TypeCache.GetType(TypeName);
             string typeName = $"{nameof(System)}."
                 + MarshalAs switch
                 {
@@ -90,7 +85,7 @@ namespace Qt.DotNet
                 }
                 + (IsArray ? "[]" : "");
 
-            var type = Type.GetType(typeName);
+            var type = TypeCache.GetType(typeName);
             if (type != null)
                 TypeName = typeName;
             return type;
@@ -121,6 +116,11 @@ namespace Qt.DotNet
         public bool IsFixedLength => FLAG(ParamInfo >> FLAGS_OFFSET, FLAGS_FIXEDLENGTH_BIT);
         public bool IsWeakRef => FLAG(ParamInfo >> FLAGS_OFFSET, FLAGS_WEAKREF_BIT);
         public int ArrayLength => (int)MASK(ParamInfo >> ARRAYLENGTH_OFFSET, ARRAYLENGTH_SIZE);
+        public int PrepareMode
+            => (int)MASK(ParamInfo >> (FLAGS_OFFSET + FLAGS_PREPARE_BIT), FLAGS_PREPARE_SIZE);
+        public Parameter WithPrepareMode(int mode) => new(TypeName, ParamInfo
+            & ~(MASK(ulong.MaxValue, FLAGS_PREPARE_SIZE) << (FLAGS_OFFSET + FLAGS_PREPARE_BIT))
+            | MASK((ulong)mode, FLAGS_PREPARE_SIZE) << (FLAGS_OFFSET + FLAGS_PREPARE_BIT));
         public bool IsVoid => string.IsNullOrEmpty(TypeName) && MarshalAs == 0;
         public static Parameter Void { get; } = new();
     }
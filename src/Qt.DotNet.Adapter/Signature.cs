@@ -0,0 +1,193 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Collections.Concurrent;
+using System.Diagnostics.CodeAnalysis;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet
+{
+    /// <summary>
+    /// Signature of a method, i.e. the parameter info of the return type followed by the
+    /// parameter info of each argument. Signatures are registered once, and are identified by
+    /// an integer ID afterwards; native code may then resolve methods by signature ID, with no
+    /// parameter info being marshaled. Caches of generated code are also keyed by signature ID.
+    /// </summary>
+    internal sealed class Signature
+    {
+        public int Id { get; }
+        public Parameter[] Parameters { get; }
+        public int Length => Parameters.Length;
+
+        private readonly Type[] types;
+
+        private Signature(int id, Parameter[] parameters)
+        {
+            Id = id;
+            Parameters = parameters;
+            types = new Type[parameters.Length];
+        }
+
+        /// <summary>
+        /// Get the type of a parameter. Types that are found are kept for later calls.
+        /// </summary>
+        /// <param name="index">Index of the parameter (0 is the return type)</param>
+        /// <returns>Parameter type, or null if not found</returns>
+        public Type GetParameterType(int index)
+        {
+            if (types[index] is { } type)
+                return type;
+            // Parameter.GetParameterType() might modify the parameter, so use a copy
+            var parameter = Parameters[index];
+            return types[index] = parameter.GetParameterType();
+        }
+
+        /// <summary>
+        /// Get the types of a range of parameters, e.g. the types of the method's arguments.
+        /// </summary>
+        /// <param name="skip">Number of parameters to skip</param>
+        /// <returns>Array of parameter types</returns>
+        /// <exception cref="ArgumentException">If a type is not found</exception>
+        public Type[] GetParameterTypes(int skip)
+        {
+            var parameterTypes = new Type[Math.Max(Length - skip, 0)];
+            for (int i = 0; i < parameterTypes.Length; ++i) {
+                parameterTypes[i] = GetParameterType(skip + i)
+                    ?? throw new ArgumentException($"Type not found [{i}]", "parameters");
+            }
+            return parameterTypes;
+        }
+
+        /// <summary>
+        /// Get the signature with the given parameters, registering it if needed. The prepare
+        /// mode (see Adapter.PrepareMode) is not part of the signature.
+        /// </summary>
+        public static Signature Get(Parameter[] parameters)
+        {
+            parameters ??= Array.Empty<Parameter>();
+            if (ByParameters.TryGetValue(parameters, out var signature))
+                return signature;
+
+            var key = parameters.ToArray();
+            if (key.Length > 0)
+                key[0] = key[0].WithPrepareMode((int)Adapter.PrepareMode.Default);
+            signature = ByParameters.GetOrAdd(key,
+                _ => new Signature(Interlocked.Increment(ref LastId), key));
+            ById.TryAdd(signature.Id, signature);
+            return signature;
+        }
+
+        /// <summary>
+        /// Get the signature with the parameters passed by native code, registering it if needed.
+        /// Signatures already seen are found by comparing the native parameter info in place, so
+        /// that no parameter list or type name strings are allocated on each call.
+        /// </summary>
+        public static unsafe Signature Get(int count, Adapter.NativeParameter* parameters)
+        {
+            if (parameters == null)
+                count = 0;
+            var hashCode = new HashCode();
+            for (int i = 0; i < count; ++i) {
+                hashCode.Add(GetParamInfo(parameters, i));
+                hashCode.Add(string.GetHashCode(GetTypeName(parameters, i)));
+            }
+            var slot = hashCode.ToHashCode() & (ByNativeParameters.Length - 1);
+            if (ByNativeParameters[slot] is { } signature && signature.Equals(count, parameters))
+                return signature;
+
+            var managedParameters = new Parameter[count];
+            for (int i = 0; i < count; ++i) {
+                managedParameters[i] = new Parameter(
+                    Marshal.PtrToStringUni(parameters[i].TypeName), parameters[i].ParamInfo);
+            }
+            return ByNativeParameters[slot] = Get(managedParameters);
+        }
+
+        private unsafe bool Equals(int count, Adapter.NativeParameter* parameters)
+        {
+            if (Length != count)
+                return false;
+            for (int i = 0; i < count; ++i) {
+                if (Parameters[i].ParamInfo != GetParamInfo(parameters, i))
+                    return false;
+                if (!GetTypeName(parameters, i).SequenceEqual(Parameters[i].TypeName))
+                    return false;
+            }
+            return true;
+        }
+
+        private static unsafe ulong GetParamInfo(Adapter.NativeParameter* parameters, int index)
+        {
+            var paramInfo = parameters[index].ParamInfo;
+            return index == 0
+                ? new Parameter(string.Empty, paramInfo)
+                    .WithPrepareMode((int)Adapter.PrepareMode.Default).ParamInfo
+                : paramInfo;
+        }
+
+        private static unsafe ReadOnlySpan<char> GetTypeName(
+            Adapter.NativeParameter* parameters,
+            int index)
+        {
+            return MemoryMarshal.CreateReadOnlySpanFromNullTerminated(
+                (char*)parameters[index].TypeName);
+        }
+
+        /// <summary>
+        /// Get a registered signature.
+        /// </summary>
+        /// <exception cref="ArgumentException">If the signature ID is not valid</exception>
+        public static Signature Get(int id)
+        {
+            return ById.TryGetValue(id, out var signature)
+                ? signature
+                : throw new ArgumentException("Invalid signature ID", nameof(id));
+        }
+
+        private static int LastId;
+
+        private static ConcurrentDictionary<Parameter[], Signature> ByParameters { get; }
+            = new(new Comparer());
+
+        private static ConcurrentDictionary<int, Signature> ById { get; } = new();
+
+        /// <summary>
+        /// Lookup table of signatures by hash of the native parameter info. Entries are
+        /// overwritten on collision; a hit is always checked against the parameter info.
+        /// </summary>
+        private static Signature[] ByNativeParameters { get; } = new Signature[1024];
+
+        /// <summary>
+        /// Structural comparison of parameter lists.
+        /// </summary>
+        private class Comparer : IEqualityComparer<Parameter[]>
+        {
+            public bool Equals(Parameter[] x, Parameter[] y)
+            {
+                if (ReferenceEquals(x, y))
+                    return true;
+                if (x == null || y == null || x.Length != y.Length)
+                    return false;
+                for (int i = 0; i < x.Length; ++i) {
+                    if (x[i].ParamInfo != y[i].ParamInfo)
+                        return false;
+                    if ((x[i].TypeName ?? string.Empty) != (y[i].TypeName ?? string.Empty))
+                        return false;
+                }
+                return true;
+            }
+
+            public int GetHashCode([DisallowNull] Parameter[] obj)
+            {
+                var hashCode = new HashCode();
+                foreach (var parameter in obj) {
+                    hashCode.Add(parameter.ParamInfo);
+                    hashCode.Add(parameter.TypeName ?? string.Empty);
+                }
+                return hashCode.ToHashCode();
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Collections.Concurrent;
+using System.Reflection;
+
+namespace Qt.DotNet
+{
+    /// <summary>
+    /// Types by name, shared by all adapter operations. Type names that are not found are also
+    /// kept, until another assembly is loaded. Hits and misses are reported in the adapter
+    /// counters (see Adapter.Counter).
+    /// </summary>
+    internal static class TypeCache
+    {
+        private static ConcurrentDictionary<string, Type> Types { get; } = new();
+        private static ConcurrentDictionary<Type, Type> CustomNativeTypes { get; } = new();
+
+        // Incremented on assembly load; a miss is only kept if no assembly was loaded meanwhile
+        private static int Generation = 0;
+
+        static TypeCache()
+        {
+            AppDomain.CurrentDomain.AssemblyLoad += (_, _) => ForgetMissing();
+        }
+
+        /// <summary>
+        /// Get a type by name (see Type.GetType()).
+        /// </summary>
+        /// <param name="typeName">Fully qualified name of type</param>
+        /// <returns>Type, or null if not found</returns>
+        public static Type GetType(string typeName)
+        {
+            if (string.IsNullOrEmpty(typeName))
+                return null;
+            if (Types.TryGetValue(typeName, out var type)) {
+                Adapter.IncrementCounter(Adapter.Counter.TypeCacheHits);
+                return type;
+            }
+            Adapter.IncrementCounter(Adapter.Counter.TypeCacheMisses);
+
+            var generation = Volatile.Read(ref Generation);
+            type = Type.GetType(typeName);
+            if (type != null)
+                return Types.GetOrAdd(typeName, type);
+            if (Volatile.Read(ref Generation) == generation)
+                Types.TryAdd(typeName, null);
+            return null;
+        }
+
+        /// <summary>
+        /// Get the native type of a custom marshaler (see IAdapterCustomMarshaler.NativeType).
+        /// </summary>
+        /// <param name="customMarshalerType">Type of custom marshaler</param>
+        /// <returns>Native type, or object if not provided by the custom marshaler</returns>
+        public static Type GetCustomNativeType(Type customMarshalerType)
+        {
+            return CustomNativeTypes.GetOrAdd(customMarshalerType, marshalerType =>
+            {
+                if (marshalerType.IsAssignableTo(typeof(IAdapterCustomMarshaler))) {
+                    var nativeType = marshalerType.GetProperty(
+                        "NativeType", BindingFlags.Public | BindingFlags.Static);
+                    if (nativeType != null && nativeType.GetValue(null) is Type customType)
+                        return customType;
+                }
+                return typeof(object);
+            });
+        }
+
+        private static void ForgetMissing()
+        {
+            Interlocked.Increment(ref Generation);
+            foreach (var missing in Types.Where(x => x.Value == null))
+                Types.TryRemove(missing);
+        }
+    }
+}
@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+// <auto-generated>
+//     This code was generated by a tool.
+//
+//     Changes to this file may cause incorrect behavior and will be lost if
+//     the code is regenerated.
+// </auto-generated>
+//------------------------------------------------------------------------------
+
+using System;
+using System.Reflection;
+
+[assembly: System.Reflection.AssemblyCompanyAttribute("Qt.DotNet.Adapter")]
+[assembly: System.Reflection.AssemblyConfigurationAttribute("Tests")]
+[assembly: System.Reflection.AssemblyFileVersionAttribute("1.0.0.0")]
+[assembly: System.Reflection.AssemblyInformationalVersionAttribute("1.0.0+4c6f5ab1d9a327ad4da0402f137743722ecc9198")]
+[assembly: System.Reflection.AssemblyProductAttribute("Qt.DotNet.Adapter")]
+[assembly: System.Reflection.AssemblyTitleAttribute("Qt.DotNet.Adapter")]
+[assembly: System.Reflection.AssemblyVersionAttribute("1.0.0.0")]
+
+// Generated by the MSBuild WriteCodeFragment class.
+
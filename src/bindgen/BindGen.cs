@@ -0,0 +1,94 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Qt.DotNet.BindGen
+{
+    /// <summary>
+    /// Build-time generator of C++ wrapper headers for the public types of a .NET assembly.
+    /// The assembly is inspected through its metadata only (see MetadataLoadContext); no code
+    /// of the assembly is loaded for execution.
+    /// </summary>
+    internal static class BindGen
+    {
+        private const string Usage =
+            "Usage: bindgen <assembly> -o <header> [-t <type>]... [-r <reference>]...\n"
+            + "  <assembly>        Path to the .NET assembly\n"
+            + "  -o <header>       Path to the generated C++ header\n"
+            + "  -t <type>         Full name of a type to wrap (default: all public classes)\n"
+            + "  -r <reference>    Path to an assembly referenced by the input assembly";
+
+        private static int Main(string[] args)
+        {
+            string assemblyPath = null;
+            string outputPath = null;
+            var typeNames = new List<string>();
+            var references = new List<string>();
+            for (int i = 0; i < args.Length; ++i) {
+                switch (args[i]) {
+                case "-o" when i + 1 < args.Length:
+                    outputPath = args[++i];
+                    break;
+                case "-t" when i + 1 < args.Length:
+                    typeNames.Add(args[++i]);
+                    break;
+                case "-r" when i + 1 < args.Length:
+                    references.Add(Path.GetFullPath(args[++i]));
+                    break;
+                default:
+                    if (args[i].StartsWith('-') || assemblyPath != null) {
+                        Console.Error.WriteLine(Usage);
+                        return 1;
+                    }
+                    assemblyPath = Path.GetFullPath(args[i]);
+                    break;
+                }
+            }
+            if (assemblyPath == null || outputPath == null) {
+                Console.Error.WriteLine(Usage);
+                return 1;
+            }
+
+            try {
+                using var context = new MetadataLoadContext(
+                    new PathAssemblyResolver(GetResolverPaths(assemblyPath, references)));
+                var assembly = context.LoadFromAssemblyPath(assemblyPath);
+                var header = new HeaderWriter(assembly, typeNames).Write();
+
+                // Unchanged headers are not written, so that dependent sources are not rebuilt
+                if (File.Exists(outputPath) && File.ReadAllText(outputPath) == header)
+                    return 0;
+                var outputDir = Path.GetDirectoryName(Path.GetFullPath(outputPath));
+                if (!string.IsNullOrEmpty(outputDir))
+                    Directory.CreateDirectory(outputDir);
+                File.WriteAllText(outputPath, header);
+                return 0;
+            } catch (Exception e) {
+                Console.Error.WriteLine($"bindgen: {e.Message}");
+                return 2;
+            }
+        }
+
+        /// <summary>
+        /// Assemblies available to the metadata load context: the input assembly and others in
+        /// the same directory, explicit references, and the assemblies of the running .NET
+        /// runtime. Only the first assembly found with a given name is used.
+        /// </summary>
+        private static IEnumerable<string> GetResolverPaths(
+            string assemblyPath, IEnumerable<string> references)
+        {
+            var assemblyDir = Path.GetDirectoryName(assemblyPath) ?? ".";
+            var runtimeDir = RuntimeEnvironment.GetRuntimeDirectory();
+            return references
+                .Prepend(assemblyPath)
+                .Concat(Directory.GetFiles(assemblyDir, "*.dll"))
+                .Concat(Directory.GetFiles(runtimeDir, "*.dll"))
+                .GroupBy(x => Path.GetFileName(x), StringComparer.OrdinalIgnoreCase)
+                .Select(x => x.First());
+        }
+    }
+}
@@ -0,0 +1,636 @@
+/***************************************************************************************************
+ Copyright (C) 2023 The Qt Company Ltd.
+ SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+***************************************************************************************************/
+
+using System.Reflection;
+using System.Text;
+
+namespace Qt.DotNet.BindGen
+{
+    /// <summary>
+    /// Writes the C++ wrapper header for the public types of an assembly. For each class, a
+    /// wrapper class derived from QDotNetObject is generated, with one member function per
+    /// public constructor, method and property accessor. Enums used by the wrapped members are
+    /// generated as C++ enums, with the marshaling traits of QDotNetTypeOf.
+    ///
+    /// Methods are resolved through a function table shared by all objects of a wrapper class.
+    /// The table holds the signature of each method, and is resolved with a single call into
+    /// the adapter (see QDotNetAdapter::resolveMany()) when the first object is created or the
+    /// first static method is called. Instance methods are resolved as open-instance methods,
+    /// i.e. once per type rather than once per object.
+    /// </summary>
+    internal class HeaderWriter
+    {
+        private enum MemberKind
+        {
+            Constructor,
+            Static,
+            Instance
+        }
+
+        /// <summary>
+        /// C++ type of a .NET type. Object references are passed to the adapter with the name
+        /// of the .NET type, so that methods are found by their exact parameter types.
+        /// </summary>
+        private class CppType
+        {
+            public string Name { get; init; }
+            public string ArgType { get; init; }
+            public string ObjectTypeName { get; init; }
+            public bool IsVoid => Name == "void";
+        }
+
+        private class Member
+        {
+            public MemberKind Kind { get; init; }
+            public string MethodName { get; init; }
+            public string CppName { get; init; }
+            public CppType ReturnType { get; init; }
+            public (CppType Type, string Name)[] Params { get; init; }
+        }
+
+        private class ClassBinding
+        {
+            public Type Type { get; init; }
+            public List<Member> Members { get; } = new();
+        }
+
+        private Assembly Assembly { get; }
+        private List<ClassBinding> Classes { get; } = new();
+        private Dictionary<string, ClassBinding> ClassesByName { get; } = new();
+        private SortedDictionary<string, Type> Enums { get; } = new(StringComparer.Ordinal);
+
+        // Members of QDotNetRef and QDotNetObject; wrapper members are renamed to avoid these
+        private static readonly HashSet<string> ReservedNames = new()
+        {
+            "adapter", "attach", "call", "cast", "constructor", "copyFrom", "equals",
+            "freeObjectRef", "functions", "gcHandle", "isValid", "method", "methods", "moveFrom",
+            "object", "staticMethod", "subscribeEvent", "toString", "type", "typeName",
+            "unsubscribeEvent"
+        };
+
+        private static readonly HashSet<string> CppKeywords = new()
+        {
+            "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool",
+            "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class",
+            "compl", "concept", "const", "consteval", "constexpr", "constinit", "const_cast",
+            "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete",
+            "do", "double", "dynamic_cast", "else", "emit", "enum", "explicit", "export",
+            "extern", "false", "float", "for", "foreach", "friend", "goto", "if", "inline",
+            "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr",
+            "operator", "or", "or_eq", "private", "protected", "public", "register",
+            "reinterpret_cast", "requires", "return", "short", "signals", "signed", "sizeof",
+            "slots", "static", "static_assert", "static_cast", "struct", "switch", "template",
+            "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+            "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while",
+            "xor", "xor_eq"
+        };
+
+        public HeaderWriter(Assembly assembly, IReadOnlyCollection<string> typeNames)
+        {
+            Assembly = assembly;
+            var types = assembly.GetExportedTypes()
+                .Where(x => typeNames.Count == 0 || typeNames.Contains(x.FullName))
+                .OrderBy(x => x.FullName, StringComparer.Ordinal)
+                .ToList();
+            foreach (var typeName in typeNames) {
+                if (!types.Any(x => x.FullName == typeName))
+                    throw new ArgumentException($"Type '{typeName}' not found");
+            }
+
+            foreach (var type in types.Where(x => x.IsEnum))
+                AddEnum(type);
+            foreach (var type in types.Where(IsWrappable)) {
+                var binding = new ClassBinding { Type = type };
+                Classes.Add(binding);
+                ClassesByName.Add(type.FullName, binding);
+            }
+            // Members are mapped once all wrapper classes are known
+            foreach (var binding in Classes)
+                AddMembers(binding);
+        }
+
+        public string Write()
+        {
+            var text = new StringBuilder();
+            var assemblyName = Assembly.GetName().Name;
+            text.AppendLine($"// Generated by bindgen from {assemblyName}. Do not edit.");
+            text.AppendLine("//");
+            text.AppendLine("// Methods of each wrapper class are resolved once, in a single");
+            text.AppendLine("// call into the adapter, and shared by all objects of the class.");
+            text.AppendLine("// The .NET types of the wrapper classes must not be freed (see");
+            text.AppendLine("// QDotNetType::freeTypeRef()) while in use.");
+            text.AppendLine();
+            text.AppendLine("#pragma once");
+            text.AppendLine();
+            text.AppendLine("#include <qdotnetadapter.h>");
+            text.AppendLine("#include <qdotnetarray.h>");
+            text.AppendLine("#include <qdotnetobject.h>");
+            text.AppendLine();
+            text.AppendLine("#include <array>");
+
+            foreach (var type in Enums.Values)
+                WriteEnum(text, type);
+            foreach (var binding in Classes)
+                WriteForwardDeclaration(text, binding);
+            foreach (var binding in Classes)
+                WriteClass(text, binding);
+            foreach (var binding in Classes)
+                WriteFunctions(text, binding);
+            return text.ToString();
+        }
+
+        private static bool IsWrappable(Type type)
+        {
+            if (!type.IsClass || type.IsGenericType || type.IsArray)
+                return false;
+            for (var baseType = type.BaseType; baseType != null; baseType = baseType.BaseType) {
+                if (baseType.FullName == "System.Delegate")
+                    return false;
+            }
+            return true;
+        }
+
+        private void AddEnum(Type type)
+        {
+            if (Enums.ContainsKey(type.FullName))
+                return;
+            if (MapPrimitive(type.GetEnumUnderlyingType()) != null)
+                Enums.Add(type.FullName, type);
+        }
+
+        private void AddMembers(ClassBinding binding)
+        {
+            var type = binding.Type;
+            var signatures = new HashSet<string>();
+            void Add(Member member)
+            {
+                // C++ overloads must differ in their argument types
+                var argTypes = member.Params.Select(x => x.Type.ArgType);
+                var key = $"{member.CppName}({string.Join(",", argTypes)})";
+                if (signatures.Add(key))
+                    binding.Members.Add(member);
+            }
+
+            if (!type.IsAbstract) {
+                var ctors = type.GetConstructors(BindingFlags.Public | BindingFlags.Instance);
+                foreach (var ctor in ctors) {
+                    var parameters = MapParameters(ctor);
+                    if (parameters == null)
+                        continue;
+                    // Would hide the copy constructor or the object reference constructor
+                    if (parameters.Length == 1 && (parameters[0].Type.Name == CppName(type)
+                        || parameters[0].Type.Name == "void *")) {
+                        continue;
+                    }
+                    Add(new Member
+                    {
+                        Kind = MemberKind.Constructor,
+                        CppName = ClassName(type),
+                        ReturnType = MapType(type),
+                        Params = parameters
+                    });
+                }
+            }
+
+            var methods = type
+                .GetMethods(BindingFlags.Public | BindingFlags.Instance | BindingFlags.Static)
+                .Where(x => !x.IsGenericMethodDefinition)
+                .Where(x => x.GetBaseDefinition().DeclaringType?.FullName != "System.Object")
+                .Where(x => !x.IsSpecialName
+                    || x.Name.StartsWith("get_") || x.Name.StartsWith("set_"))
+                .OrderBy(x => x.Name, StringComparer.Ordinal)
+                .ThenBy(x => x.GetParameters().Length);
+            foreach (var method in methods) {
+                var returnType = MapType(method.ReturnType);
+                var parameters = MapParameters(method);
+                if (returnType == null || parameters == null)
+                    continue;
+                Add(new Member
+                {
+                    Kind = method.IsStatic ? MemberKind.Static : MemberKind.Instance,
+                    MethodName = method.Name,
+                    CppName = MemberName(method),
+                    ReturnType = returnType,
+                    Params = parameters
+                });
+            }
+        }
+
+        private (CppType Type, string Name)[] MapParameters(MethodBase method)
+        {
+            var parameters = method.GetParameters();
+            var mapped = new (CppType Type, string Name)[parameters.Length];
+            for (int i = 0; i < parameters.Length; ++i) {
+                if (parameters[i].ParameterType.IsByRef || parameters[i].IsOut)
+                    return null;
+                var type = MapType(parameters[i].ParameterType);
+                if (type == null || type.IsVoid)
+                    return null;
+                var name = parameters[i].Name;
+                mapped[i] = (type, Escape(string.IsNullOrEmpty(name) ? $"arg{i}" : name));
+            }
+            return mapped;
+        }
+
+        private static CppType MapPrimitive(Type type)
+        {
+            var name = type.FullName switch
+            {
+                "System.Void" => "void",
+                "System.Boolean" => "bool",
+                "System.SByte" => "qint8",
+                "System.Byte" => "quint8",
+                "System.Int16" => "qint16",
+                "System.UInt16" => "quint16",
+                "System.Int32" => "qint32",
+                "System.UInt32" => "quint32",
+                "System.Int64" => "qint64",
+                "System.UInt64" => "quint64",
+                "System.Single" => "float",
+                "System.Double" => "double",
+                "System.IntPtr" => "void *",
+                "System.String" => "QString",
+                _ => null
+            };
+            if (name == null)
+                return null;
+            return new CppType
+            {
+                Name = name,
+                ArgType = name == "QString" ? "const QString &" : name
+            };
+        }
+
+        private CppType MapType(Type type)
+        {
+            if (type.IsByRef || type.IsPointer || type.ContainsGenericParameters)
+                return null;
+            if (MapPrimitive(type) is { } primitive)
+                return primitive;
+            if (type.IsEnum) {
+                AddEnum(type);
+                if (!Enums.ContainsKey(type.FullName))
+                    return null;
+                return new CppType { Name = CppName(type), ArgType = CppName(type) };
+            }
+            if (type.IsArray) {
+                if (type.GetArrayRank() != 1)
+                    return null;
+                var elementType = type.GetElementType();
+                if (elementType == null)
+                    return null;
+                // Element types must provide QDotNetTypeOf (see QDotNetArray)
+                var element = MapPrimitive(elementType)
+                    ?? (ClassesByName.ContainsKey(elementType.FullName ?? "")
+                        ? MapType(elementType) : null);
+                if (element == null || element.IsVoid || element.Name == "void *")
+                    return null;
+                var arrayName = $"QDotNetArray<{element.Name}>";
+                return new CppType
+                {
+                    Name = arrayName,
+                    ArgType = $"const {arrayName} &",
+                    ObjectTypeName = DotNetName(type)
+                };
+            }
+            if (type.IsValueType || type.IsGenericType)
+                return null;
+            var className = ClassesByName.ContainsKey(type.FullName ?? "")
+                ? CppName(type) : "QDotNetObject";
+            return new CppType
+            {
+                Name = className,
+                ArgType = $"const {className} &",
+                ObjectTypeName = DotNetName(type)
+            };
+        }
+
+        /// <summary>
+        /// Name of a type as passed to the adapter, i.e. the full name of the type and, except
+        /// for types of the core library, the name of its assembly.
+        /// </summary>
+        private static string DotNetName(Type type)
+        {
+            var elementType = type;
+            while (elementType.HasElementType)
+                elementType = elementType.GetElementType();
+            var assemblyName = elementType?.Assembly.GetName().Name;
+            if (assemblyName is null or "System.Private.CoreLib" or "mscorlib")
+                return type.FullName;
+            return $"{type.FullName}, {assemblyName}";
+        }
+
+        private static string ClassName(Type type)
+        {
+            var name = type.FullName ?? type.Name;
+            if (!string.IsNullOrEmpty(type.Namespace))
+                name = name[(type.Namespace.Length + 1)..];
+            return Escape(name.Replace('+', '_'));
+        }
+
+        private static IEnumerable<string> NamespaceOf(Type type)
+        {
+            return (type.Namespace ?? "")
+                .Split('.', StringSplitOptions.RemoveEmptyEntries)
+                .Select(Escape)
+                .Prepend("QDotNetTypes");
+        }
+
+        private static string CppName(Type type)
+        {
+            return $"{string.Join("::", NamespaceOf(type))}::{ClassName(type)}";
+        }
+
+        private static string MemberName(MethodInfo method)
+        {
+            var name = method.Name;
+            if (method.IsSpecialName && name.StartsWith("get_"))
+                name = CamelCase(name[4..]);
+            else if (method.IsSpecialName && name.StartsWith("set_"))
+                name = $"set{name[4..]}";
+            else
+                name = CamelCase(name);
+            return ReservedNames.Contains(name) ? $"{name}_" : Escape(name);
+        }
+
+        /// <summary>
+        /// Lower-case initial, including leading acronyms, e.g. 'IsUnc' -> 'isUnc',
+        /// 'IPAddress' -> 'ipAddress'.
+        /// </summary>
+        private static string CamelCase(string name)
+        {
+            int upper = 0;
+            while (upper < name.Length && char.IsUpper(name[upper]))
+                ++upper;
+            if (upper == 0)
+                return name;
+            if (upper > 1 && upper < name.Length)
+                --upper;
+            return name[..upper].ToLowerInvariant() + name[upper..];
+        }
+
+        private static string Escape(string name)
+        {
+            return CppKeywords.Contains(name) ? $"{name}_" : name;
+        }
+
+        private static void OpenNamespace(StringBuilder text, IEnumerable<string> ns)
+        {
+            text.AppendLine();
+            text.AppendLine(string.Join(" ", ns.Select(x => $"namespace {x} {{")));
+        }
+
+        private static void CloseNamespace(StringBuilder text, IEnumerable<string> ns)
+        {
+            text.AppendLine(string.Join(" ", ns.Select(_ => "}")));
+        }
+
+        private static void WriteEnum(StringBuilder text, Type type)
+        {
+            var underlyingType = MapPrimitive(type.GetEnumUnderlyingType());
+            var ns = NamespaceOf(type).ToList();
+            OpenNamespace(text, ns);
+            text.AppendLine($"    enum class {ClassName(type)} : {underlyingType.Name}");
+            text.AppendLine("    {");
+            var values = type.GetFields(BindingFlags.Public | BindingFlags.Static)
+                .Select(x => $"        {Escape(x.Name)} = {EnumValue(x.GetRawConstantValue())}");
+            text.AppendLine(string.Join($",{Environment.NewLine}", values));
+            text.AppendLine("    };");
+            CloseNamespace(text, ns);
+
+            var marshalAs = type.GetEnumUnderlyingType().FullName switch
+            {
+                "System.SByte" => "I1",
+                "System.Byte" => "U1",
+                "System.Int16" => "I2",
+                "System.UInt16" => "U2",
+                "System.UInt32" => "U4",
+                "System.Int64" => "I8",
+                "System.UInt64" => "U8",
+                _ => "I4"
+            };
+            text.AppendLine();
+            text.AppendLine("template<>");
+            text.AppendLine($"struct QDotNetTypeOf<{CppName(type)}>");
+            text.AppendLine("{");
+            text.AppendLine("    static inline const QString TypeName =");
+            text.AppendLine($"        QStringLiteral(\"{DotNetName(type)}\");");
+            text.AppendLine(
+                $"    static inline UnmanagedType MarshalAs = UnmanagedType::{marshalAs};");
+            text.AppendLine("};");
+        }
+
+        private static string EnumValue(object value)
+        {
+            return value switch
+            {
+                long x when x == long.MinValue => "(-9223372036854775807ll - 1)",
+                long x => $"{x}ll",
+                ulong x => $"{x}ull",
+                uint x => $"{x}u",
+                int x when x == int.MinValue => "(-2147483647 - 1)",
+                _ => Convert.ToString(value, System.Globalization.CultureInfo.InvariantCulture)
+            };
+        }
+
+        private static void WriteForwardDeclaration(StringBuilder text, ClassBinding binding)
+        {
+            var ns = NamespaceOf(binding.Type).ToList();
+            OpenNamespace(text, ns);
+            text.AppendLine($"    class {ClassName(binding.Type)};");
+            CloseNamespace(text, ns);
+        }
+
+        private static string Declaration(Member member, string className = null)
+        {
+            var args = string.Join(", ", member.Params.Select(x => Argument(x.Type, x.Name)));
+            var scope = className != null ? $"{className}::" : "";
+            return member.Kind switch
+            {
+                MemberKind.Constructor => $"{scope}{member.CppName}({args})",
+                MemberKind.Static when className == null
+                    => $"static {member.ReturnType.Name} {member.CppName}({args})",
+                MemberKind.Static => $"{member.ReturnType.Name} {scope}{member.CppName}({args})",
+                _ => $"{member.ReturnType.Name} {scope}{member.CppName}({args}) const"
+            };
+        }
+
+        private static string Argument(CppType type, string name)
+        {
+            return type.ArgType.EndsWith('&') || type.ArgType.EndsWith('*')
+                ? $"{type.ArgType}{name}" : $"{type.ArgType} {name}";
+        }
+
+        private static void WriteClass(StringBuilder text, ClassBinding binding)
+        {
+            var type = binding.Type;
+            var className = ClassName(type);
+            var ns = NamespaceOf(type).ToList();
+            OpenNamespace(text, ns);
+            text.AppendLine($"    class {className} : public QDotNetObject");
+            text.AppendLine("    {");
+            text.AppendLine("    public:");
+            text.AppendLine(
+                $"        Q_DOTNET_OBJECT_INLINE({className}, \"{DotNetName(type)}\");");
+            text.AppendLine();
+            foreach (var member in binding.Members)
+                text.AppendLine($"        {Declaration(member)};");
+            if (binding.Members.Count > 0)
+                text.AppendLine();
+            text.AppendLine("    private:");
+            text.AppendLine("        struct Functions;");
+            text.AppendLine("        static const Functions &functions();");
+            text.AppendLine("    };");
+            CloseNamespace(text, ns);
+        }
+
+        private static string FunctionType(Member member)
+        {
+            var types = member.Params.Select(x => x.Type.Name).Prepend(member.ReturnType.Name);
+            return $"QDotNetFunction<{string.Join(", ", types)}>";
+        }
+
+        private static void WriteFunctions(StringBuilder text, ClassBinding binding)
+        {
+            var type = binding.Type;
+            var className = ClassName(type);
+            var members = binding.Members;
+            var ns = NamespaceOf(type).ToList();
+            OpenNamespace(text, ns);
+
+            // Function table, with the signature of each method
+            text.AppendLine($"    struct {className}::Functions");
+            text.AppendLine("    {");
+            for (int i = 0; i < members.Count; ++i)
+                text.AppendLine($"        {FunctionType(members[i])} fn{i};");
+            if (members.Count > 0)
+                text.AppendLine();
+            text.AppendLine("        Functions()");
+            text.AppendLine("        {");
+            if (members.Count > 0)
+                WriteResolve(text, members);
+            text.AppendLine("        }");
+            text.AppendLine("    };");
+            text.AppendLine();
+            text.AppendLine($"    inline const {className}::Functions &{className}::functions()");
+            text.AppendLine("    {");
+            text.AppendLine("        static const Functions fns;");
+            text.AppendLine("        return fns;");
+            text.AppendLine("    }");
+
+            for (int i = 0; i < members.Count; ++i) {
+                var member = members[i];
+                var args = string.Join(", ", member.Params.Select(x => x.Name));
+                text.AppendLine();
+                switch (member.Kind) {
+                case MemberKind.Constructor:
+                    text.AppendLine($"    inline {Declaration(member, className)}");
+                    text.AppendLine("        : QDotNetObject(nullptr)");
+                    text.AppendLine("    {");
+                    text.AppendLine($"        *this = functions().fn{i}({args});");
+                    text.AppendLine("    }");
+                    break;
+                case MemberKind.Static:
+                    text.AppendLine($"    inline {Declaration(member, className)}");
+                    text.AppendLine("    {");
+                    text.AppendLine(member.ReturnType.IsVoid
+                        ? $"        functions().fn{i}({args});"
+                        : $"        return functions().fn{i}({args});");
+                    text.AppendLine("    }");
+                    break;
+                default:
+                    var invokeArgs = string.Join(", ",
+                        member.Params.Select(x => x.Name).Prepend("*this"));
+                    text.AppendLine($"    inline {Declaration(member, className)}");
+                    text.AppendLine("    {");
+                    text.AppendLine(member.ReturnType.IsVoid
+                        ? $"        functions().fn{i}.invoke({invokeArgs});"
+                        : $"        return functions().fn{i}.invoke({invokeArgs});");
+                    text.AppendLine("    }");
+                    break;
+                }
+            }
+            CloseNamespace(text, ns);
+        }
+
+        private static void WriteResolve(StringBuilder text, List<Member> members)
+        {
+            // Names of .NET types passed by object reference, which must outlive the signatures
+            var objectTypeNames = members
+                .SelectMany(x => x.Params.Select(y => y.Type).Prepend(x.ReturnType))
+                .Select(x => x.ObjectTypeName)
+                .Where(x => x != null)
+                .Distinct()
+                .OrderBy(x => x, StringComparer.Ordinal)
+                .ToList();
+            string Parameter(CppType type, bool inbound)
+            {
+                if (type.ObjectTypeName != null) {
+                    var index = objectTypeNames.IndexOf(type.ObjectTypeName);
+                    return $"QDotNetParameter(typeNames[{index}], UnmanagedType::ObjectRef)";
+                }
+                return $"QDotNet{(inbound ? "Inbound" : "Outbound")}<{type.Name}>::Parameter";
+            }
+
+            text.AppendLine("            using Kind = QDotNetAdapter::ResolveKind;");
+            text.AppendLine("            const QString typeNames[] =");
+            text.AppendLine("            {");
+            var separator = objectTypeNames.Count > 0 ? "," : "";
+            text.AppendLine($"                FullyQualifiedTypeName{separator}");
+            if (objectTypeNames.Count > 0) {
+                text.AppendLine(string.Join($",{Environment.NewLine}",
+                    objectTypeNames.Select(x => $"                QStringLiteral(\"{x}\")")));
+            }
+            text.AppendLine("            };");
+            // typeNames[0] is the wrapped type itself
+            objectTypeNames.Insert(0, null);
+
+            for (int i = 0; i < members.Count; ++i) {
+                var member = members[i];
+                var parameters = new List<string>();
+                if (member.Kind == MemberKind.Constructor) {
+                    parameters.Add("QDotNetParameter(typeNames[0], UnmanagedType::ObjectRef)");
+                } else {
+                    parameters.Add(Parameter(member.ReturnType, inbound: true));
+                    if (member.Kind == MemberKind.Instance)
+                        parameters.Add("QDotNetParameter(typeNames[0], UnmanagedType::ObjectRef)");
+                }
+                parameters.AddRange(member.Params.Select(x => Parameter(x.Type, inbound: false)));
+
+                text.AppendLine(
+                    $"            const std::array<QDotNetParameter, {parameters.Count}> sig{i}");
+                text.AppendLine("            {");
+                text.AppendLine(string.Join($",{Environment.NewLine}",
+                    parameters.Select(x => $"                {x}")));
+                text.AppendLine("            };");
+            }
+
+            text.AppendLine("            const auto &adapter = QDotNetAdapter::instance();");
+            text.AppendLine("            const QList<void *> funcPtrs = adapter.resolveMany(");
+            text.AppendLine("                FullyQualifiedTypeName, {");
+            for (int i = 0; i < members.Count; ++i) {
+                var member = members[i];
+                var kind = member.Kind switch
+                {
+                    MemberKind.Constructor => "Kind::Constructor",
+                    MemberKind.Static => "Kind::Static",
+                    _ => "Kind::OpenInstance"
+                };
+                var methodName = member.MethodName != null
+                    ? $"QStringLiteral(\"{member.MethodName}\")" : "{}";
+                separator = i + 1 < members.Count ? "," : "";
+                var request = $"{{ {kind}, {methodName}, QDotNetSignature(sig{i}) }}";
+                text.AppendLine($"                    {request}{separator}");
+            }
+            text.AppendLine("                });");
+            for (int i = 0; i < members.Count; ++i) {
+                var kind = members[i].Kind == MemberKind.Instance
+                    ? ", QDotNetFunctionKind::OpenInstance" : "";
+                var funcPtr = $"funcPtrs.value({i}){kind}";
+                text.AppendLine($"            fn{i} = {FunctionType(members[i])}({funcPtr});");
+            }
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include <qdotnetarray.h>
 #include <qdotnetcallback.h>
 #include <qdotnethost.h>
+#include <qdotnethostoptions.h>
 #include <qdotnetmarshal.h>
 #include <qdotnetobject.h>
 #include <qdotnetsafemethod.h>
@@ -24,11 +25,15 @@
 #include <QDebug>
 #include <QDir>
 #include <QElapsedTimer>
+#include <QFuture>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QObject>
 #include <QSignalSpy>
 #include <QString>
+#include <QTemporaryDir>
 
 #include <QtTest>
 #ifdef __GNUC__
@@ -43,7 +48,9 @@ public:
     tst_qtdotnet() = default;
 
 private slots:
+    void hostOptions();
     void loadHost();
+    void startupTimings();
     void runtimeProperties();
     void resolveFunction();
     void callFunction();
@@ -51,10 +58,21 @@ private slots:
     void callDefaultEntryPoint();
     void callWithComplexArg();
     void adapterInit();
+    void adapterStartup();
+    void warmUpAsync();
+    void startProfile();
+    void prepareMethods();
     void callStaticMethod();
     void handleException();
     void createObject();
     void callInstanceMethod();
+    void callOpenInstanceMethod();
+    void resolveCache();
+    void callSiteCache();
+    void signatures();
+    void resolveMany();
+    void typeCache();
+    void generatedCode();
     void useWrapperClass();
     void emitSignalFromEvent();
     void propertyBinding();
@@ -62,16 +80,116 @@ private slots:
     void arrayOfInts();
     void arrayOfStrings();
     void arrayOfObjects();
+    void replayProfile();
+    void gcInfo();
     void unloadHost();
 };
 
 QDotNetHost dotNetHost;
 
+void tst_qtdotnet::hostOptions()
+{
+    QDotNetHostOptions options;
+    QVERIFY(options.isDefault());
+    QVERIFY(options.isValid());
+
+    const QDotNetHostOptions fastStartup(QDotNetHostOptions::Profile::FastStartup);
+    QVERIFY(fastStartup.isValid());
+    QVERIFY(fastStartup.tieredPGO() == false);
+    QVERIFY(fastStartup.quickJitForLoops() == true);
+    QCOMPARE(fastStartup.environment().value(QDotNetHostOptions::ReadyToRunVariable), "1");
+    const QJsonObject config = QJsonDocument::fromJson(fastStartup.runtimeConfig().toUtf8())
+        .object()["runtimeOptions"].toObject();
+    QCOMPARE(config["tfm"].toString(), "net6.0");
+    const QJsonObject configProperties = config["configProperties"].toObject();
+    QCOMPARE(configProperties[QDotNetHostOptions::InvariantGlobalization].toBool(), true);
+    QCOMPARE(configProperties[QDotNetHostOptions::TieredPGO].toBool(true), false);
+
+    const QDotNetHostOptions peakThroughput(QDotNetHostOptions::Profile::PeakThroughput);
+    QVERIFY(peakThroughput.isValid());
+    QVERIFY(peakThroughput.tieredPGO() == true);
+    QVERIFY(!peakThroughput.invariantGlobalization().has_value());
+    QCOMPARE(peakThroughput.environment().value(QDotNetHostOptions::ReadyToRunVariable), "0");
+
+    options.setTieredCompilation(false);
+    options.setTieredPGO(true);
+    QVERIFY(!options.isDefault());
+    QCOMPARE(options.validate().size(), 1);
+    options.setTieredPGO(false);
+    QVERIFY(options.isValid());
+    options.setConfigProperty(QDotNetHostOptions::QuickJit, "yes");
+    QVERIFY(!options.isValid());
+
+    QDotNetHostOptions cacheOptions;
+    cacheOptions.setCodeCacheDirectory(QDir::tempPath());
+    QVERIFY(cacheOptions.isValid());
+    QCOMPARE(cacheOptions.codeCacheDirectory(), QDir::tempPath());
+    cacheOptions.setConfigProperty(QDotNetHostOptions::CodeCacheDirectory, 42);
+    QVERIFY(!cacheOptions.isValid());
+    cacheOptions.setCodeCacheDirectory({});
+    QVERIFY(cacheOptions.isDefault());
+
+    QDotNetHostOptions gcOptions;
+    gcOptions.setHeapHardLimit(256 * 1024 * 1024);
+    gcOptions.setConserveMemory(5);
+    gcOptions.setRetainVM(true);
+    QVERIFY(gcOptions.isValid());
+    QVERIFY(gcOptions.heapHardLimit() == 256u * 1024 * 1024);
+    QVERIFY(gcOptions.conserveMemory() == 5);
+    gcOptions.setHeapAffinitizeMask(0x3);
+    QVERIFY(!gcOptions.isValid());
+    gcOptions.setServerGC(true);
+    QVERIFY(gcOptions.isValid());
+    // 64-bit values are kept exactly, including masks with the high bit set
+    gcOptions.setHeapAffinitizeMask(0x8000000000000001ull);
+    QVERIFY(gcOptions.isValid());
+    QVERIFY(gcOptions.heapAffinitizeMask() == 0x8000000000000001ull);
+    QCOMPARE(gcOptions.configProperty(QDotNetHostOptions::HeapAffinitizeMask).toString(),
+        "0x8000000000000001");
+    gcOptions.setConfigProperty(QDotNetHostOptions::HeapHardLimit, 1e17);
+    QVERIFY(!gcOptions.isValid());
+    gcOptions.setHeapHardLimit(~quint64(0));
+    QVERIFY(gcOptions.heapHardLimit() == ~quint64(0));
+    QVERIFY(gcOptions.isValid());
+    gcOptions.setConserveMemory(10);
+    QVERIFY(!gcOptions.isValid());
+    // Checked before narrowing to int
+    gcOptions.setConfigProperty(QDotNetHostOptions::ConserveMemory, "0x100000000");
+    QVERIFY(!gcOptions.isValid());
+}
+
+// GC mode for the gcInfo() benchmark, set in QTDOTNET_TEST_GC_MODE:
+// "workstation" (default), "server", "nonconcurrent" or "conserve".
+const QString gcMode = qEnvironmentVariable("QTDOTNET_TEST_GC_MODE", "workstation");
+
 void tst_qtdotnet::loadHost()
 {
+    QDotNetHostOptions options;
+    options.setTieredCompilation(true);
+    options.setReadyToRun(true);
+    if (gcMode == "server")
+        options.setServerGC(true);
+    else if (gcMode == "nonconcurrent")
+        options.setConcurrentGC(false);
+    else if (gcMode == "conserve")
+        options.setConserveMemory(5);
     QVERIFY(!dotNetHost.isLoaded());
+    QFuture<bool> loaded = dotNetHost.loadAsync(options);
+    // Early callers block until the runtime is loaded with the options passed to loadAsync().
     QVERIFY(dotNetHost.load());
     QVERIFY(dotNetHost.isLoaded());
+    QVERIFY(loaded.result());
+}
+
+void tst_qtdotnet::startupTimings()
+{
+    QVERIFY(dotNetHost.isLoaded());
+    const QMap<QString, qint64> timings = dotNetHost.startupTimings();
+    QVERIFY(timings.contains("findRuntime"));
+    QVERIFY(timings.contains("loadRuntime"));
+    QVERIFY(timings.contains("initRuntime"));
+    for (auto timing = timings.constBegin(); timing != timings.constEnd(); ++timing)
+        qInfo() << timing.key() << "=" << timing.value() / 1000 << "usecs";
 }
 
 void tst_qtdotnet::runtimeProperties()
@@ -79,6 +197,8 @@ void tst_qtdotnet::runtimeProperties()
     QVERIFY(dotNetHost.isLoaded());
     QMap<QString, QString> runtimeProperties = dotNetHost.runtimeProperties();
     QVERIFY(!runtimeProperties.isEmpty());
+    QCOMPARE(runtimeProperties.value(QDotNetHostOptions::TieredCompilation), "true");
+    QCOMPARE(runtimeProperties.value(QDotNetHostOptions::ReadyToRunVariable), "1");
     for (auto prop = runtimeProperties.constBegin(); prop != runtimeProperties.constEnd(); ++prop) {
         qInfo() << prop.key() << "=" << QString("%1%2")
             .arg(prop.value().left(100)).arg(prop.value().length() > 100 ? "..." : "");
@@ -216,15 +336,96 @@ void tst_qtdotnet::callWithComplexArg()
     QCOMPARE(formattedText, "Today is 2022-12-25");
 }
 
+qint64 adapterInitNsecs = 0;
+
 void tst_qtdotnet::adapterInit()
 {
     QVERIFY(!QDotNetAdapter::instance().isValid());
+    QElapsedTimer timer;
+    timer.start();
     QDotNetAdapter::instance().init(
         QDir(QCoreApplication::applicationDirPath()).filePath("Qt.DotNet.Adapter.dll"),
         "Qt.DotNet.Adapter", "Qt.DotNet.Adapter", &dotNetHost);
+    adapterInitNsecs = timer.nsecsElapsed();
     QVERIFY(QDotNetAdapter::instance().isValid());
 }
 
+void tst_qtdotnet::adapterStartup()
+{
+    QVERIFY(QDotNetAdapter::instance().isValid());
+    QElapsedTimer timer;
+
+    // Functions not provided by the adapter bootstrap are resolved on first call.
+    timer.start();
+    QVERIFY(QDotNetAdapter::instance().stats().allZero());
+    const qint64 firstCallNsecs = timer.nsecsElapsed();
+
+    // Resolve all remaining functions up-front.
+    timer.restart();
+    QVERIFY(QDotNetAdapter::instance().resolveAll());
+    const qint64 resolveAllNsecs = timer.nsecsElapsed();
+
+    timer.restart();
+    QVERIFY(QDotNetAdapter::instance().stats().allZero());
+    const qint64 resolvedCallNsecs = timer.nsecsElapsed();
+
+    qInfo() << "lazy init =" << adapterInitNsecs / 1000 << "usecs";
+    qInfo() << "eager init =" << (adapterInitNsecs + firstCallNsecs + resolveAllNsecs) / 1000
+        << "usecs";
+    qInfo() << "first call (lazy) =" << firstCallNsecs / 1000 << "usecs";
+    qInfo() << "first call (eager) =" << resolvedCallNsecs / 1000 << "usecs";
+}
+
+void tst_qtdotnet::warmUpAsync()
+{
+    QDotNetFunction<QString, QString> getEnvironmentVariable;
+    QFuture<bool> warmUp = QDotNetAdapter::warmUpAsync(&dotNetHost, {
+        [&getEnvironmentVariable] {
+            getEnvironmentVariable = QDotNetType::staticMethod<QString, QString>(
+                "System.Environment", "GetEnvironmentVariable");
+        }
+    });
+    QVERIFY(warmUp.result());
+    QVERIFY(getEnvironmentVariable.isValid());
+    QCOMPARE(getEnvironmentVariable("PATH"), qEnvironmentVariable("PATH"));
+}
+
+void tst_qtdotnet::startProfile()
+{
+    QDotNetAdapter::instance().startProfile();
+}
+
+void tst_qtdotnet::prepareMethods()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    const qint64 prepared = adapter.counter(QDotNetAdapter::Counter::PreparedMethods);
+
+    adapter.setPrepareMode(QDotNetAdapter::PrepareMode::Sync);
+    const auto expandEnvironmentVariables = QDotNetType::staticMethod<QString, QString>(
+        "System.Environment", "ExpandEnvironmentVariables");
+    QVERIFY(expandEnvironmentVariables.isValid());
+    QCOMPARE(adapter.counter(QDotNetAdapter::Counter::PreparedMethods), prepared + 1);
+    QElapsedTimer timer;
+    timer.start();
+    QCOMPARE(expandEnvironmentVariables("qtdotnet"), "qtdotnet");
+    qInfo() << "first call (prepared) =" << timer.nsecsElapsed() / 1000 << "usecs";
+
+    adapter.setPrepareMode(QDotNetAdapter::PrepareMode::Off);
+    const QDotNetFunction<qint32, qint32, qint32> max = adapter.resolveStaticMethod(
+        "System.Math", "Max", {
+            QDotNetInbound<qint32>::Parameter,
+            QDotNetOutbound<qint32>::Parameter,
+            QDotNetOutbound<qint32>::Parameter
+        }, QDotNetAdapter::PrepareMode::Background);
+    QVERIFY(max.isValid());
+    QTRY_COMPARE(adapter.counter(QDotNetAdapter::Counter::PreparedMethods), prepared + 2);
+    QCOMPARE(max(1, 2), 2);
+    QCOMPARE(adapter.counter(QDotNetAdapter::Counter::PrepareFailures), 0);
+
+    adapter.freeTypeRef("System.Environment");
+    adapter.freeTypeRef("System.Math");
+}
+
 void tst_qtdotnet::callStaticMethod()
 {
     QVERIFY(QDotNetAdapter::instance().stats().refCount == 0);
@@ -267,6 +468,309 @@ void tst_qtdotnet::callInstanceMethod()
     QVERIFY(QDotNetAdapter::instance().stats().refCount == 0);
 }
 
+void tst_qtdotnet::callOpenInstanceMethod()
+{
+    QVERIFY(QDotNetAdapter::instance().stats().refCount == 0);
+    {
+        const QString typeName = QStringLiteral("System.Text.StringBuilder");
+        const auto newStringBuilder = QDotNetObject::constructor(typeName);
+        const auto append = QDotNetType::instanceMethod<QDotNetObject, QString>(
+            typeName, "Append");
+        QVERIFY(append.isValid());
+        QVERIFY(append.isOpenInstance());
+
+        QList<QDotNetObject> stringBuilders;
+        for (int i = 0; i < 3; ++i)
+            stringBuilders.append(newStringBuilder());
+        for (int i = 0; i < stringBuilders.size(); ++i)
+            std::ignore = append.invoke(stringBuilders[i], QString::number(i));
+        for (int i = 0; i < stringBuilders.size(); ++i)
+            QCOMPARE(stringBuilders[i].toString(), QString::number(i));
+
+        // Resolved once, shared by all objects of the type
+        const auto appendAgain = QDotNetType::instanceMethod<QDotNetObject, QString>(
+            typeName, "Append");
+        QCOMPARE(appendAgain.ptr(), append.ptr());
+        QDotNetType::freeTypeRef(typeName);
+    }
+    QVERIFY(QDotNetAdapter::instance().stats().refCount == 0);
+}
+
+void tst_qtdotnet::resolveCache()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    QVERIFY(adapter.stats().refCount == 0);
+    const QList<QDotNetParameter> minInt = {
+        QDotNetInbound<qint32>::Parameter,
+        QDotNetOutbound<qint32>::Parameter,
+        QDotNetOutbound<qint32>::Parameter
+    };
+    const QList<QDotNetParameter> minLong = {
+        QDotNetInbound<qint64>::Parameter,
+        QDotNetOutbound<qint64>::Parameter,
+        QDotNetOutbound<qint64>::Parameter
+    };
+    const auto stats = adapter.resolveCacheStats();
+
+    void *minIntPtr = adapter.resolveStaticMethod("System.Math", "Min", minInt);
+    QVERIFY(minIntPtr != nullptr);
+    QCOMPARE(adapter.resolveCacheStats().misses, stats.misses + 1);
+    QCOMPARE(adapter.resolveStaticMethod("System.Math", "Min", minInt), minIntPtr);
+    QCOMPARE(adapter.resolveCacheStats().hits, stats.hits + 1);
+
+    void *minLongPtr = adapter.resolveStaticMethod("System.Math", "Min", minLong);
+    QVERIFY(minLongPtr != nullptr);
+    QVERIFY(minLongPtr != minIntPtr);
+    QCOMPARE(adapter.resolveCacheStats().misses, stats.misses + 2);
+    QCOMPARE(adapter.resolveCacheStats().size, stats.size + 2);
+
+    // Releasing the type releases its static methods, which are then removed from the cache
+    adapter.freeTypeRef("System.Math");
+    QCOMPARE(adapter.resolveCacheStats().size, stats.size);
+    const QDotNetFunction<qint32, qint32, qint32> min
+        = adapter.resolveStaticMethod("System.Math", "Min", minInt);
+    QVERIFY(min.isValid());
+    QCOMPARE(adapter.resolveCacheStats().misses, stats.misses + 3);
+    QCOMPARE(min(1, 2), 1);
+    adapter.freeTypeRef("System.Math");
+
+    qint64 cacheSize = 0;
+    {
+        const auto newStringBuilder = QDotNetObject::constructor("System.Text.StringBuilder");
+        const QDotNetObject stringBuilder = newStringBuilder();
+        cacheSize = adapter.resolveCacheStats().size;
+        const QList<QDotNetParameter> append = {
+            QDotNetInbound<QDotNetObject>::Parameter,
+            QDotNetOutbound<QString>::Parameter
+        };
+        void *appendPtr = adapter.resolveInstanceMethod(stringBuilder, "Append", append);
+        QVERIFY(appendPtr != nullptr);
+        QCOMPARE(adapter.resolveInstanceMethod(stringBuilder, "Append", append), appendPtr);
+        QCOMPARE(adapter.resolveCacheStats().size, cacheSize + 1);
+    }
+    // Releasing the object removes its instance methods from the cache
+    QCOMPARE(adapter.resolveCacheStats().size, cacheSize);
+    adapter.freeTypeRef("System.Text.StringBuilder");
+    QVERIFY(adapter.stats().refCount == 0);
+}
+
+void tst_qtdotnet::callSiteCache()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    QVERIFY(adapter.stats().refCount == 0);
+    {
+        const auto newStringBuilder = QDotNetObject::constructor("System.Text.StringBuilder");
+        const QDotNetObject stringBuilder = newStringBuilder();
+        QVERIFY(stringBuilder.typeName().startsWith("System.Text.StringBuilder, "));
+
+        std::ignore = stringBuilder.call<QDotNetObject, QString>("Append", "Hello");
+        const auto stats = adapter.resolveCacheStats();
+        std::ignore = stringBuilder.call<QDotNetObject, QString>("Append", " World!");
+        const QDotNetObject other = newStringBuilder();
+        std::ignore = other.call<QDotNetObject, QString>("Append", "Hello");
+        // Method cached at the call site, for all objects of the type
+        QCOMPARE(adapter.resolveCacheStats().hits, stats.hits);
+        QCOMPARE(adapter.resolveCacheStats().misses, stats.misses);
+        QCOMPARE(stringBuilder.toString(), "Hello World!");
+        QCOMPARE(other.toString(), "Hello");
+
+        constexpr int iterations = 10000;
+        const auto getLength = stringBuilder.method<qint32>("get_Length");
+        const QString getLengthName = QStringLiteral("get_Length");
+        std::ignore = stringBuilder.call<qint32>(getLengthName);
+        qint64 totalLength = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i)
+            totalLength += getLength();
+        const qint64 functionNsecs = timer.nsecsElapsed();
+        timer.restart();
+        for (int i = 0; i < iterations; ++i)
+            totalLength += stringBuilder.call<qint32>(getLengthName);
+        const qint64 callNsecs = timer.nsecsElapsed();
+        QCOMPARE(totalLength, qint64(2 * iterations * 12));
+        qInfo() << "QDotNetFunction =" << functionNsecs / iterations << "nsecs/call";
+        qInfo() << "QDotNetObject::call() =" << callNsecs / iterations << "nsecs/call";
+    }
+    {
+        QCOMPARE((QtDotNet::call<qint32, qint32, qint32>("System.Math", "Max", 1, 2)), 2);
+        const auto stats = adapter.resolveCacheStats();
+        QCOMPARE((QtDotNet::call<qint32, qint32, qint32>("System.Math", "Max", 3, 2)), 3);
+        QCOMPARE(adapter.resolveCacheStats().misses, stats.misses);
+        QCOMPARE(adapter.resolveCacheStats().hits, stats.hits);
+
+        // Releasing the type invalidates methods cached at call sites
+        adapter.freeTypeRef("System.Math");
+        QCOMPARE((QtDotNet::call<qint32, qint32, qint32>("System.Math", "Max", 4, 5)), 5);
+        QCOMPARE(adapter.resolveCacheStats().misses, stats.misses + 1);
+        adapter.freeTypeRef("System.Math");
+    }
+    {
+        // Failures to resolve static methods are not cached at the call site, so that they can
+        // be resolved after loading the assembly that declares them
+        QDotNetCallSite<QString, QString, qint32> callSite;
+        const QString typeName = QStringLiteral("FooLib.Foo, FooLib");
+        const QString noSuchType = QStringLiteral("FooLib.NoSuchType, FooLib");
+        QVERIFY(!callSite.staticMethod(noSuchType, "FormatNumber").isValid());
+        const auto stats = adapter.resolveCacheStats();
+        QVERIFY(!callSite.staticMethod(noSuchType, "FormatNumber").isValid());
+        QCOMPARE(adapter.resolveCacheStats().misses, stats.misses + 1);
+
+        QVERIFY(adapter.loadAssembly("FooLib"));
+        const auto &formatNumber = callSite.staticMethod(typeName, "FormatNumber");
+        QVERIFY(formatNumber.isValid());
+        QCOMPARE(formatNumber.invoke(nullptr, "{0:D3}", 7), "007");
+        QCOMPARE(&callSite.staticMethod(typeName, "FormatNumber"), &formatNumber);
+        adapter.freeTypeRef(typeName);
+    }
+    adapter.freeTypeRef("System.Text.StringBuilder");
+    QVERIFY(adapter.stats().refCount == 0);
+}
+
+void tst_qtdotnet::signatures()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    QVERIFY(adapter.stats().refCount == 0);
+
+    // Signatures are built once per combination of types
+    const auto minInt = QtDotNet::signature<qint32, qint32, qint32>();
+    QCOMPARE(minInt.size(), 3);
+    QCOMPARE((QtDotNet::signature<qint32, qint32, qint32>().data()), minInt.data());
+    QCOMPARE((QtDotNet::signature<qint32, qint32, qint32>().hash()), minInt.hash());
+    const auto minLong = QtDotNet::signature<qint64, qint64, qint64>();
+    QVERIFY(minLong.hash() != minInt.hash());
+
+    // Hash depends only on the contents of the signature
+    const QList<QDotNetParameter> minIntList = {
+        QDotNetInbound<qint32>::Parameter,
+        QDotNetOutbound<qint32>::Parameter,
+        QDotNetOutbound<qint32>::Parameter
+    };
+    QCOMPARE(QDotNetSignature(minIntList).hash(), minInt.hash());
+    const QString objectTypeName = QStringLiteral("System.Object");
+    const QString stringBuilderTypeName = QStringLiteral("System.Text.StringBuilder");
+    const QList<QDotNetParameter> objectArg = {
+        QDotNetInbound<void>::Parameter,
+        QDotNetParameter(objectTypeName, UnmanagedType::ObjectRef)
+    };
+    const QList<QDotNetParameter> stringBuilderArg = {
+        QDotNetInbound<void>::Parameter,
+        QDotNetParameter(stringBuilderTypeName, UnmanagedType::ObjectRef)
+    };
+    QVERIFY(QDotNetSignature(objectArg).hash() != QDotNetSignature(stringBuilderArg).hash());
+
+    // Signatures are registered once; equal signatures get the same ID
+    const qint32 minIntId = adapter.registerSignature(minInt);
+    QVERIFY(minIntId > 0);
+    QCOMPARE(adapter.registerSignature(QDotNetSignature(minIntList)), minIntId);
+    QVERIFY(adapter.registerSignature(minLong) > 0);
+    QVERIFY(adapter.registerSignature(minLong) != minIntId);
+
+    // Methods resolved with an equivalent list of parameters share the same cache entry
+    void *minIntPtr = adapter.resolveStaticMethod("System.Math", "Min", minInt);
+    QVERIFY(minIntPtr != nullptr);
+    const auto stats = adapter.resolveCacheStats();
+    QCOMPARE(adapter.resolveStaticMethod("System.Math", "Min", minIntList), minIntPtr);
+    QCOMPARE(adapter.resolveCacheStats().hits, stats.hits + 1);
+    QCOMPARE((QDotNetFunction<qint32, qint32, qint32>(minIntPtr)(3, 2)), 2);
+    adapter.freeTypeRef("System.Math");
+    QVERIFY(adapter.stats().refCount == 0);
+}
+
+void tst_qtdotnet::resolveMany()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    QVERIFY(adapter.stats().refCount == 0);
+    using Kind = QDotNetAdapter::ResolveKind;
+    const QString mathTypeName = QStringLiteral("System.Math");
+    const QString stringBuilderTypeName = QStringLiteral("System.Text.StringBuilder");
+    const std::array<QDotNetParameter, 1> newStringBuilder
+    {
+        QDotNetParameter(stringBuilderTypeName, UnmanagedType::ObjectRef)
+    };
+
+    // Static methods and constructors of a type, in one call
+    auto stats = adapter.resolveCacheStats();
+    const QList<void *> funcPtrs = adapter.resolveMany(mathTypeName, {
+        { Kind::Static, "Min", QtDotNet::signature<qint32, qint32, qint32>() },
+        { Kind::Static, "Max", QtDotNet::signature<qint32, qint32, qint32>() },
+        { Kind::Static, "NoSuchMethod", QtDotNet::signature<qint32, qint32, qint32>() },
+        { Kind::Constructor, {}, QDotNetSignature(newStringBuilder) }
+    });
+    QCOMPARE(funcPtrs.size(), 4);
+    QCOMPARE(adapter.resolveCacheStats().misses, stats.misses + 4);
+    QCOMPARE((QDotNetFunction<qint32, qint32, qint32>(funcPtrs[0])(3, 2)), 2);
+    QCOMPARE((QDotNetFunction<qint32, qint32, qint32>(funcPtrs[1])(3, 2)), 3);
+    QVERIFY(funcPtrs[2] == nullptr);
+    QVERIFY(funcPtrs[3] != nullptr);
+
+    // Methods resolved in a batch are cached as if resolved one at a time
+    stats = adapter.resolveCacheStats();
+    QCOMPARE(adapter.resolveStaticMethod(mathTypeName, "Max",
+        QtDotNet::signature<qint32, qint32, qint32>()), funcPtrs[1]);
+    QCOMPARE(adapter.resolveCacheStats().hits, stats.hits + 1);
+
+    // Instance methods of an object, with the wrapper class helper
+    {
+        const QDotNetFunction<QDotNetObject> ctor(funcPtrs[3]);
+        const QDotNetObject stringBuilder = ctor();
+        QDotNetFunction<QDotNetObject, QString> append;
+        QDotNetSafeMethod<qint32> getLength;
+        QDotNetFunction<QString> toString;
+        stringBuilder.methods({ "Append", "get_Length", "ToString" },
+            append, getLength, toString);
+        QVERIFY(append.isValid() && getLength.isValid() && toString.isValid());
+        std::ignore = append("Hello");
+        QCOMPARE(getLength.invoke(stringBuilder), 5);
+        QCOMPARE(toString(), "Hello");
+    }
+
+    QDotNetFunction<qint64, qint64, qint64> minLong;
+    QDotNetFunction<qint64, qint64, qint64> maxLong;
+    QDotNetType::staticMethods(mathTypeName, { "Min", "Max" }, minLong, maxLong);
+    QCOMPARE(minLong(1, 2), qint64(1));
+    QCOMPARE(maxLong(1, 2), qint64(2));
+
+    adapter.freeTypeRef(mathTypeName);
+    adapter.freeTypeRef(stringBuilderTypeName);
+    QVERIFY(adapter.stats().refCount == 0);
+}
+
+void tst_qtdotnet::typeCache()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    adapter.freeTypeRef("System.Math");
+    const qint64 hits = adapter.counter(QDotNetAdapter::Counter::TypeCacheHits);
+    const qint64 misses = adapter.counter(QDotNetAdapter::Counter::TypeCacheMisses);
+
+    adapter.freeTypeRef("System.Math");
+    adapter.freeTypeRef("System.Math");
+    QCOMPARE(adapter.counter(QDotNetAdapter::Counter::TypeCacheHits), hits + 2);
+    QCOMPARE(adapter.counter(QDotNetAdapter::Counter::TypeCacheMisses), misses);
+}
+
+void tst_qtdotnet::generatedCode()
+{
+    const QDotNetAdapter &adapter = QDotNetAdapter::instance();
+    QVERIFY(adapter.stats().refCount == 0);
+    const QString typeName = QStringLiteral("System.Text.StringBuilder");
+    const qint64 generatedMethods = adapter.counter(QDotNetAdapter::Counter::GeneratedMethods);
+    {
+        // String argument is marshaled: called through a generated proxy method
+        const auto append = QDotNetType::instanceMethod<QDotNetObject, QString>(
+            typeName, "Append");
+        QVERIFY(append.isValid());
+        QVERIFY(adapter.counter(QDotNetAdapter::Counter::GeneratedMethods) > generatedMethods);
+        QVERIFY(adapter.counter(QDotNetAdapter::Counter::LiveGeneratedCode) > 0);
+    }
+
+    // Proxy method is dropped from the code generator caches when the type is released
+    const qint64 evicted = adapter.counter(QDotNetAdapter::Counter::EvictedGeneratedCode);
+    QDotNetType::freeTypeRef(typeName);
+    QVERIFY(adapter.counter(QDotNetAdapter::Counter::EvictedGeneratedCode) > evicted);
+    QVERIFY(adapter.stats().refCount == 0);
+}
+
 void tst_qtdotnet::useWrapperClass()
 {
     QVERIFY(QDotNetAdapter::instance().stats().refCount == 0);
@@ -275,9 +779,16 @@ void tst_qtdotnet::useWrapperClass()
         QVERIFY(QDotNetAdapter::instance().stats().refCount == 1);
         QVERIFY(sb.isValid());
         sb.append("Hello").append(" ");
+        // Copies share the GC handle
         StringBuilder sbCpy(sb);
-        QVERIFY(QDotNetAdapter::instance().stats().refCount == 2);
+        QVERIFY(QDotNetAdapter::instance().stats().refCount == 1);
         QVERIFY(sbCpy.isValid());
+        QCOMPARE(sbCpy.gcHandle(), sb.gcHandle());
+        {
+            const QList<StringBuilder> copies(100, sb);
+            QVERIFY(QDotNetAdapter::instance().stats().refCount == 1);
+        }
+        QVERIFY(sb.isValid());
         sbCpy.append("World");
         sb = StringBuilder(std::move(sbCpy));
         QVERIFY(QDotNetAdapter::instance().stats().refCount == 1);
@@ -495,6 +1006,39 @@ void tst_qtdotnet::arrayOfObjects()
     QVERIFY(QDotNetAdapter::instance().stats().refCount == 0);
 }
 
+void tst_qtdotnet::replayProfile()
+{
+    QTemporaryDir profileDir;
+    QVERIFY(profileDir.isValid());
+    const QString profilePath = profileDir.filePath("startup.profile");
+    QVERIFY(QDotNetAdapter::instance().saveProfile(profilePath));
+
+    QVERIFY(QDotNetAdapter::replayProfileAsync(profilePath, &dotNetHost).result());
+
+    QElapsedTimer timer;
+    timer.start();
+    const qint32 count = QDotNetAdapter::instance().replayProfile(profilePath);
+    const qint64 replayNsecs = timer.nsecsElapsed();
+    QVERIFY(count > 0);
+    QCOMPARE(QDotNetAdapter::instance().replayProfile(profileDir.filePath("none.profile")), -1);
+    qInfo() << "replay profile =" << count << "methods," << replayNsecs / 1000 << "usecs";
+}
+
+void tst_qtdotnet::gcInfo()
+{
+    const auto gcInfo = QDotNetAdapter::instance().gcInfo();
+    QVERIFY(gcInfo.totalAvailableMemoryBytes > 0);
+    QCOMPARE(gcInfo.isServerGC != 0, gcMode == "server");
+
+    qInfo() << "GC mode =" << gcMode << "latency mode =" << gcInfo.latencyMode;
+    qInfo() << "heap size =" << gcInfo.heapSizeBytes / 1024 << "KB";
+    qInfo() << "committed =" << gcInfo.totalCommittedBytes / 1024 << "KB";
+    qInfo() << "collections =" << gcInfo.gen0Collections << "/" << gcInfo.gen1Collections
+        << "/" << gcInfo.gen2Collections;
+    qInfo() << "last pause =" << gcInfo.lastPauseDurationTicks / 10 << "usecs";
+    qInfo() << "pause time =" << gcInfo.pauseTimePercentage << "%";
+}
+
 void tst_qtdotnet::unloadHost()
 {
     QVERIFY(dotNetHost.isLoaded());